@@ -0,0 +1,188 @@
+// audio.cpp - Sound effects for M5Core2 Tetris
+//
+// Every effect is synthesized once at boot into a shared PCM pool. The
+// game only drops effect IDs into a lock-free queue; a mixer task owns the
+// voices and the I2S speaker, so no game event ever waits on audio. The
+// task runs on core 0, away from loop(), but a flash write stalls both
+// cores: the four queued DMA blocks (64 ms) cover a log append, not a
+// sector erase, which is one more reason persist only writes between games.
+#include "audio.h"
+#include "spsc_ring.h"
+#include "memmon.h"
+#include <driver/i2s.h>
+
+#define SPEAKER_I2S_PORT I2S_NUM_0
+#define SPEAKER_PIN_BCK 12
+#define SPEAKER_PIN_LRCK 0
+#define SPEAKER_PIN_DATA 2
+
+#define WAVE_SQUARE 0
+#define WAVE_TRIANGLE 1
+#define WAVE_NOISE 2
+
+// Up to three tones back to back, each sweeping startHz -> endHz
+struct ToneSpec {
+  uint16_t startHz;
+  uint16_t endHz;
+  uint16_t ms;
+  uint8_t wave;
+};
+
+static const ToneSpec EFFECT_TONES[SFX_COUNT][3] = {
+  {{880, 1100, 30, WAVE_SQUARE}},                                   // Rotate
+  {{660, 440, 35, WAVE_TRIANGLE}, {440, 660, 35, WAVE_TRIANGLE}},   // Hold
+  {{400, 80, 60, WAVE_NOISE}},                                      // Hard drop
+  {{523, 523, 50, WAVE_SQUARE}, {784, 1046, 100, WAVE_SQUARE}},     // Line clear
+  {{523, 523, 80, WAVE_SQUARE}, {659, 659, 80, WAVE_SQUARE}, {784, 1568, 200, WAVE_SQUARE}}, // Tetris
+  {{440, 330, 200, WAVE_TRIANGLE}, {330, 220, 200, WAVE_TRIANGLE}, {220, 110, 200, WAVE_TRIANGLE}} // Game over
+};
+
+struct Voice {
+  const int8_t* data;
+  int remaining;
+};
+
+static int8_t pool[AUDIO_POOL_SAMPLES];
+static const int8_t* effectData[SFX_COUNT];
+static int effectLength[SFX_COUNT];
+static SpscRing<uint8_t, AUDIO_QUEUE_SIZE> commands;
+static Voice voices[AUDIO_VOICES];  // Owned by whoever calls mixBlock()
+static TaskHandle_t mixerTaskHandle = NULL;
+static bool mixerReady = false;
+
+// Fill pool from offset with one tone; returns samples written
+static int synthTone(const ToneSpec& tone, int offset) {
+  int samples = (uint32_t)tone.ms * AUDIO_SAMPLE_RATE / 1000;
+  if (samples > AUDIO_POOL_SAMPLES - offset) samples = AUDIO_POOL_SAMPLES - offset;
+  
+  uint32_t phase = 0;
+  uint32_t noise = 0x12345678;
+  for (int i = 0; i < samples; i++) {
+    uint32_t hz = tone.startHz + (int32_t)(tone.endHz - tone.startHz) * i / samples;
+    phase += (hz << 16) / AUDIO_SAMPLE_RATE;  // 16.16 cycles
+    
+    int value;
+    uint16_t p = phase & 0xFFFF;
+    if (tone.wave == WAVE_SQUARE) {
+      value = p < 0x8000 ? 127 : -127;
+    } else if (tone.wave == WAVE_TRIANGLE) {
+      value = p < 0x8000 ? (p >> 7) - 128 : 383 - (p >> 7);
+    } else {
+      // New random level once per cycle gives pitched noise
+      if (p < (hz << 16) / AUDIO_SAMPLE_RATE) noise = noise * 1664525 + 1013904223;
+      value = (int8_t)(noise >> 24);
+    }
+    
+    // Linear fade out so tones don't click
+    pool[offset + i] = value * (samples - i) / samples;
+  }
+  return samples;
+}
+
+static void synthesizeEffects() {
+  int offset = 0;
+  for (int e = 0; e < SFX_COUNT; e++) {
+    effectData[e] = &pool[offset];
+    int start = offset;
+    for (int t = 0; t < 3 && EFFECT_TONES[e][t].ms > 0; t++) {
+      offset += synthTone(EFFECT_TONES[e][t], offset);
+    }
+    effectLength[e] = offset - start;
+  }
+}
+
+static void startVoice(uint8_t effect) {
+  // Take a free voice, or steal the one closest to finishing
+  int best = 0;
+  for (int v = 0; v < AUDIO_VOICES; v++) {
+    if (voices[v].remaining < voices[best].remaining) best = v;
+  }
+  voices[best].data = effectData[effect];
+  voices[best].remaining = effectLength[effect];
+}
+
+// Start queued effects and mix the next block. Leaves the block alone
+// and returns false when nothing is playing.
+bool mixBlock(int16_t* block) {
+  uint8_t effect;
+  while (commands.pop(effect)) {
+    startVoice(effect);
+  }
+  
+  bool active = false;
+  for (int v = 0; v < AUDIO_VOICES; v++) {
+    if (voices[v].remaining > 0) active = true;
+  }
+  if (!active) return false;
+  
+  for (int i = 0; i < AUDIO_BLOCK; i++) {
+    int32_t mix = 0;
+    for (int v = 0; v < AUDIO_VOICES; v++) {
+      if (voices[v].remaining > 0) {
+        mix += *voices[v].data++ * 64;
+        voices[v].remaining--;
+      }
+    }
+    block[i] = mix > 32767 ? 32767 : (mix < -32768 ? -32768 : mix);
+  }
+  return true;
+}
+
+static void mixerTask(void* param) {
+  static int16_t block[AUDIO_BLOCK];
+  size_t written;
+  
+  for (;;) {
+    if (!mixBlock(block)) {
+      // Nothing playing: stop feeding the speaker until playSound() wakes us
+      i2s_zero_dma_buffer(SPEAKER_I2S_PORT);
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      continue;
+    }
+    i2s_write(SPEAKER_I2S_PORT, block, sizeof(block), &written, portMAX_DELAY);
+  }
+}
+
+void initAudioMixer() {
+  synthesizeEffects();
+  memset(voices, 0, sizeof(voices));
+  mixerReady = true;
+}
+
+void initAudio() {
+  i2s_config_t config;
+  memset(&config, 0, sizeof(config));
+  config.mode = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_TX);
+  config.sample_rate = AUDIO_SAMPLE_RATE;
+  config.bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT;
+  config.channel_format = I2S_CHANNEL_FMT_ONLY_RIGHT;
+  config.communication_format = I2S_COMM_FORMAT_I2S;
+  config.intr_alloc_flags = ESP_INTR_FLAG_LEVEL1;
+  config.dma_buf_count = 4;
+  config.dma_buf_len = AUDIO_BLOCK;
+  config.tx_desc_auto_clear = true;
+  
+  i2s_pin_config_t pins;
+  memset(&pins, 0, sizeof(pins));
+  pins.bck_io_num = SPEAKER_PIN_BCK;
+  pins.ws_io_num = SPEAKER_PIN_LRCK;
+  pins.data_out_num = SPEAKER_PIN_DATA;
+  pins.data_in_num = I2S_PIN_NO_CHANGE;
+  
+  if (i2s_driver_install(SPEAKER_I2S_PORT, &config, 0, NULL) != ESP_OK) return;
+  i2s_set_pin(SPEAKER_I2S_PORT, &pins);
+  M5.Axp.SetSpkEnable(true);
+  
+  initAudioMixer();
+  
+  // Above the flush task so it gets the CPU back first after a write
+  xTaskCreatePinnedToCore(mixerTask, "audio", 2048, NULL, 2, &mixerTaskHandle, 0);
+  memmonWatchTask(mixerTaskHandle, "audio");
+}
+
+void playSound(SoundEffect effect) {
+  if (!mixerReady) return;
+  if (commands.push((uint8_t)effect) && mixerTaskHandle) {
+    xTaskNotifyGive(mixerTaskHandle);
+  }
+}
@@ -0,0 +1,31 @@
+// audio.h - Sound effects for M5Core2 Tetris
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include "config.h"
+
+enum SoundEffect {
+  SFX_ROTATE,
+  SFX_HOLD,
+  SFX_HARD_DROP,
+  SFX_LINE_CLEAR,
+  SFX_TETRIS,
+  SFX_GAME_OVER,
+  SFX_COUNT
+};
+
+#define AUDIO_SAMPLE_RATE 16000
+#define AUDIO_POOL_SAMPLES 24000   // 8-bit PCM for every effect, 1.5s total
+#define AUDIO_VOICES 4             // Effects that can overlap
+#define AUDIO_BLOCK 256            // Samples mixed per I2S write
+#define AUDIO_QUEUE_SIZE 16
+
+void initAudio();
+void playSound(SoundEffect effect);  // Safe from the game loop, never blocks
+
+// The mixer without the speaker, so test/host can render effects to WAV.
+// initAudio() calls both; nothing else should call mixBlock() on the device.
+void initAudioMixer();
+bool mixBlock(int16_t* block);       // AUDIO_BLOCK samples; false if silent
+
+#endif
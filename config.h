@@ -9,6 +9,20 @@
 #define SCREEN_HEIGHT 240
 #define SCREEN_ROTATION 1  // Landscape mode
 
+// Debug/benchmark switches (can also be set with -D, see test/host)
+#ifndef ENABLE_BENCHMARKS
+#define ENABLE_BENCHMARKS 0  // Print engine benchmarks over Serial at boot
+#endif
+#ifndef ENABLE_TELEMETRY
+#define ENABLE_TELEMETRY 0   // Stream binary game state over Serial (see telemetry.h)
+#endif
+#ifndef ENABLE_SOAK
+#define ENABLE_SOAK 0        // Headless bot games for memory soak testing (see soak.cpp)
+#endif
+#ifndef PRACTICE_MODE
+#define PRACTICE_MODE 0      // Button B takes back the last piece
+#endif
+
 // Game States
 enum GameState {
   STATE_MENU,
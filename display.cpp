@@ -10,4 +10,41 @@ void initDisplay() {
 
 void clearDisplay() {
   M5.Lcd.fillScreen(COLOR_BLACK);
-}
\ No newline at end of file
+}
+
+// Streams (run length, color) pairs onto the screen one line at a time.
+// The area must already be the background color: lines that are all
+// background are skipped, and only the span between the first and last
+// drawn pixel of a line is pushed.
+void drawRleImage(int x, int y, int width, int height, const uint16_t* rle, uint16_t background) {
+  static uint16_t line[SCREEN_WIDTH];
+  uint32_t run = 0;
+  uint16_t color = background;
+  
+  M5.Lcd.startWrite();
+  for (int row = 0; row < height; row++) {
+    int first = width, last = -1;
+    for (int col = 0; col < width; ) {
+      if (run == 0) {
+        run = *rle++;
+        color = *rle++;
+      }
+      int count = min((int)run, width - col);
+      if (color != background) {
+        if (first > col) first = col;
+        last = col + count - 1;
+      }
+      for (int i = 0; i < count; i++) {
+        line[col + i] = color;
+      }
+      col += count;
+      run -= count;
+    }
+    
+    if (last >= first) {
+      M5.Lcd.setAddrWindow(x + first, y + row, last - first + 1, 1);
+      M5.Lcd.pushColors(&line[first], last - first + 1, true);
+    }
+  }
+  M5.Lcd.endWrite();
+}
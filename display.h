@@ -6,5 +6,6 @@
 
 void initDisplay();
 void clearDisplay();
+void drawRleImage(int x, int y, int width, int height, const uint16_t* rle, uint16_t background);
 
 #endif
\ No newline at end of file
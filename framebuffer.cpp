@@ -0,0 +1,114 @@
+// framebuffer.cpp - 4-bit palette framebuffers for M5Core2 Tetris
+#include "framebuffer.h"
+
+static uint16_t palette[PAL_SIZE];
+
+// Every byte value mapped to its two RGB565 pixels, already byte-swapped
+// for the LCD, so expansion is one table load and one 32-bit store
+static uint32_t pairLut[256];
+
+// Internal RAM, so the SPI driver can DMA straight out of it
+static uint16_t scanline[SCANLINE_PIXELS] __attribute__((aligned(4)));
+
+static inline uint16_t swap565(uint16_t color) {
+  return (color >> 8) | (color << 8);
+}
+
+void setPaletteColor(uint8_t index, uint16_t color) {
+  palette[index & (PAL_SIZE - 1)] = swap565(color);
+  for (int b = 0; b < 256; b++) {
+    pairLut[b] = palette[b & 0x0F] | ((uint32_t)palette[b >> 4] << 16);
+  }
+}
+
+IndexedCanvas::IndexedCanvas(uint8_t* buffer, int width, int height)
+  : pixels(buffer), width(width), height(height), stride((width + 1) / 2) {
+}
+
+void IndexedCanvas::clear(uint8_t color) {
+  memset(pixels, (color & 0x0F) * 0x11, stride * height);
+}
+
+void IndexedCanvas::fillSpan(uint8_t* row, int x, int w, uint8_t color) {
+  if (x & 1) {
+    row[x >> 1] = (row[x >> 1] & 0x0F) | (color << 4);
+    x++;
+    w--;
+  }
+  if (w >= 2) {
+    memset(&row[x >> 1], color * 0x11, w >> 1);
+    x += w & ~1;
+    w &= 1;
+  }
+  if (w > 0) {
+    row[x >> 1] = (row[x >> 1] & 0xF0) | color;
+  }
+}
+
+void IndexedCanvas::fillRect(int x, int y, int w, int h, uint8_t color) {
+  // Clip to the canvas (mini pieces can hang off the edge)
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+  if (x + w > width) w = width - x;
+  if (y + h > height) h = height - y;
+  if (w <= 0 || h <= 0) return;
+  
+  color &= 0x0F;
+  for (int yy = y; yy < y + h; yy++) {
+    fillSpan(&pixels[yy * stride], x, w, color);
+  }
+}
+
+void IndexedCanvas::drawRect(int x, int y, int w, int h, uint8_t color) {
+  fillRect(x, y, w, 1, color);
+  fillRect(x, y + h - 1, w, 1, color);
+  fillRect(x, y + 1, 1, h - 2, color);
+  fillRect(x + w - 1, y + 1, 1, h - 2, color);
+}
+
+void IndexedCanvas::expandLines(int y, int count, uint16_t* out) {
+  uint32_t* dst = (uint32_t*)out;
+  for (int line = 0; line < count; line++) {
+    const uint8_t* src = &pixels[(y + line) * stride];
+    for (int i = 0; i < width / 2; i++) {
+      *dst++ = pairLut[src[i]];
+    }
+  }
+}
+
+// One address window for the whole canvas, filled a band at a time
+void IndexedCanvas::push(int screenX, int screenY) {
+  int band = SCANLINE_PIXELS / width;
+  
+  M5.Lcd.startWrite();
+  M5.Lcd.setAddrWindow(screenX, screenY, width, height);
+  for (int y = 0; y < height; y += band) {
+    int lines = min(band, height - y);
+    expandLines(y, lines, scanline);
+    M5.Lcd.pushColors(scanline, lines * width, false);
+  }
+  M5.Lcd.endWrite();
+}
+
+#if ENABLE_BENCHMARKS
+void framebufferBenchmark(IndexedCanvas& canvas) {
+  const int runs = 100;
+  int band = SCANLINE_PIXELS / canvas.getWidth();
+  unsigned long start = micros();
+  
+  for (int r = 0; r < runs; r++) {
+    for (int y = 0; y < canvas.getHeight(); y += band) {
+      canvas.expandLines(y, min(band, canvas.getHeight() - y), scanline);
+    }
+  }
+  unsigned long expandTime = micros() - start;
+  
+  start = micros();
+  canvas.push(0, 0);
+  unsigned long pushTime = micros() - start;
+  
+  unsigned long pixels = (unsigned long)runs * canvas.getWidth() * canvas.getHeight();
+  Serial.printf("4bpp expand: %lu px in %lu us (%lu Mpx/s), one push %lu us\n",
+                pixels, expandTime, expandTime > 0 ? pixels / expandTime : 0, pushTime);
+}
+#endif
@@ -0,0 +1,44 @@
+// framebuffer.h - 4-bit palette framebuffers for M5Core2 Tetris
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include "config.h"
+
+// Palette slots; 1-7 are the piece colors so field values index directly
+#define PAL_BLACK 0
+#define PAL_WHITE 8
+#define PAL_GHOST 9
+#define PAL_SIZE 16
+
+#define SCANLINE_PIXELS 1728   // Widest canvas * lines per push (144 * 12)
+
+// Two pixels per byte, low nibble first. Drawn in RAM, then expanded to
+// RGB565 a band of lines at a time while pushing to the LCD, so a 144x216
+// field costs 15KB instead of 62KB.
+class IndexedCanvas {
+public:
+  IndexedCanvas(uint8_t* buffer, int width, int height);
+  void clear(uint8_t color);
+  void fillRect(int x, int y, int w, int h, uint8_t color);
+  void drawRect(int x, int y, int w, int h, uint8_t color);
+  void expandLines(int y, int count, uint16_t* out);
+  void push(int screenX, int screenY);
+  int getWidth() { return width; }
+  int getHeight() { return height; }
+  
+private:
+  uint8_t* pixels;
+  int width;
+  int height;
+  int stride;
+  
+  void fillSpan(uint8_t* row, int x, int w, uint8_t color);
+};
+
+void setPaletteColor(uint8_t index, uint16_t color);
+
+#if ENABLE_BENCHMARKS
+void framebufferBenchmark(IndexedCanvas& canvas);
+#endif
+
+#endif
@@ -0,0 +1,42 @@
+// gravity.cpp - Fixed-point gravity and level speed curve for M5Core2 Tetris
+#include "gravity.h"
+
+// Levels 1-11 keep the original 500ms - 40ms/level curve, then speed keeps
+// climbing past the old 100ms floor up to 20G
+static const LevelSpeed LEVEL_SPEEDS[MAX_SPEED_LEVEL] = {
+  {GRAVITY_MS_PER_ROW(500), 500},  // 1
+  {GRAVITY_MS_PER_ROW(460), 500},
+  {GRAVITY_MS_PER_ROW(420), 500},
+  {GRAVITY_MS_PER_ROW(380), 500},
+  {GRAVITY_MS_PER_ROW(340), 500},  // 5
+  {GRAVITY_MS_PER_ROW(300), 500},
+  {GRAVITY_MS_PER_ROW(260), 500},
+  {GRAVITY_MS_PER_ROW(220), 500},
+  {GRAVITY_MS_PER_ROW(180), 500},
+  {GRAVITY_MS_PER_ROW(140), 500},  // 10
+  {GRAVITY_MS_PER_ROW(100), 500},
+  {GRAVITY_MS_PER_ROW(80),  480},
+  {GRAVITY_MS_PER_ROW(60),  460},
+  {GRAVITY_MS_PER_ROW(40),  440},
+  {GRAVITY_MS_PER_ROW(25),  420},  // 15
+  {GRAVITY_G(1),            400},
+  {GRAVITY_G(2),            380},
+  {GRAVITY_G(5),            360},
+  {GRAVITY_G(10),           340},
+  {GRAVITY_G(20),           300}   // 20
+};
+
+const LevelSpeed& getLevelSpeed(int level) {
+  if (level < 1) level = 1;
+  if (level > MAX_SPEED_LEVEL) level = MAX_SPEED_LEVEL;
+  return LEVEL_SPEEDS[level - 1];
+}
+
+int gravityAdvance(uint32_t& accumulator, uint32_t elapsedUs, uint32_t gravity) {
+  if (elapsedUs > GRAVITY_MAX_STEP_US) elapsedUs = GRAVITY_MAX_STEP_US;
+  
+  accumulator += (uint32_t)((uint64_t)elapsedUs * gravity / GRAVITY_TICK_US);
+  int rows = accumulator >> GRAVITY_SHIFT;
+  accumulator &= GRAVITY_ONE - 1;
+  return rows;
+}
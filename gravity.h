@@ -0,0 +1,31 @@
+// gravity.h - Fixed-point gravity and level speed curve for M5Core2 Tetris
+#ifndef GRAVITY_H
+#define GRAVITY_H
+
+#include <stdint.h>
+
+// Gravity is rows per 60 Hz tick in 16.16 fixed point, so 1G is one row
+// per frame and 20G drops a piece to the floor instantly
+#define GRAVITY_SHIFT 16
+#define GRAVITY_ONE (1UL << GRAVITY_SHIFT)
+#define GRAVITY_TICK_US 16667
+#define GRAVITY_MAX_STEP_US 1000000  // Ignore longer stalls (e.g. menus)
+
+// Convert the old "milliseconds per row" speeds into gravity
+#define GRAVITY_MS_PER_ROW(ms) ((uint32_t)((uint64_t)GRAVITY_TICK_US * GRAVITY_ONE / ((ms) * 1000UL)))
+#define GRAVITY_G(g) ((uint32_t)((g) * GRAVITY_ONE))
+
+struct LevelSpeed {
+  uint32_t gravity;     // 16.16 rows per tick
+  uint16_t lockDelay;   // ms a grounded piece may still be moved
+};
+
+#define MAX_SPEED_LEVEL 20  // Levels beyond this keep the last entry
+
+const LevelSpeed& getLevelSpeed(int level);
+
+// Add elapsed time to the accumulator and return whole rows to fall.
+// Pure integer math, so a level run can be replayed exactly on a host.
+int gravityAdvance(uint32_t& accumulator, uint32_t elapsedUs, uint32_t gravity);
+
+#endif
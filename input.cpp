@@ -1,21 +1,82 @@
 #include "input.h"
 #include "config.h"
+#include "touch_regions.h"
 
 ButtonState buttons;
 
-// Game field constants for boundary detection
-extern const int OFFSET_X = 90;           // From tetris.h
-extern const int FIELD_WIDTH = 12;        // From tetris.h  
-extern const int FIELD_HEIGHT = 18;       // From tetris.h
-extern const int BLOCK_SIZE = 12;         // From tetris.h
-extern const int OFFSET_Y = 25;           // From tetris.h
+// Coarse 8x8 pixel grid over the touch panel, built at compile time from
+// TOUCH_REGIONS. Each cell holds the region covering all of it, or
+// REGION_MIXED when an edge runs through it.
+#define TOUCH_CELL_SHIFT 3
+#define TOUCH_CELL (1 << TOUCH_CELL_SHIFT)
+#define TOUCH_GRID_W (SCREEN_WIDTH / TOUCH_CELL)
+#define TOUCH_GRID_H (TOUCH_HEIGHT / TOUCH_CELL)
 
-// Only need hold button zone now
-HotZone_t holdButtonZone(280, 75, 300, 95); // Hold button under NEXT
+struct TouchGrid {
+  uint8_t cells[TOUCH_GRID_H][TOUCH_GRID_W];
+};
+
+static constexpr TouchGrid buildTouchGrid() {
+  TouchGrid grid = {};
+  for (int gy = 0; gy < TOUCH_GRID_H; gy++) {
+    for (int gx = 0; gx < TOUCH_GRID_W; gx++) {
+      int x0 = gx * TOUCH_CELL, x1 = x0 + TOUCH_CELL - 1;
+      int y0 = gy * TOUCH_CELL, y1 = y0 + TOUCH_CELL - 1;
+      
+      // Uniform only if every region either covers the cell or misses it
+      uint8_t cell = REGION_NONE;
+      for (int i = TOUCH_REGION_COUNT - 1; i >= 0; i--) {
+        const TouchRegion& r = TOUCH_REGIONS[i];
+        bool covers = r.x0 <= x0 && r.x1 >= x1 && r.y0 <= y0 && r.y1 >= y1;
+        bool misses = r.x1 < x0 || r.x0 > x1 || r.y1 < y0 || r.y0 > y1;
+        if (covers) {
+          cell = i;
+        } else if (!misses) {
+          cell = REGION_MIXED;
+          break;
+        }
+      }
+      grid.cells[gy][gx] = cell;
+    }
+  }
+  return grid;
+}
+
+static constexpr TouchGrid touchGrid = buildTouchGrid();
+
+// Cross-check against the plain lookup: regions are rectangles, so a
+// uniform cell must give the same answer at all four corners
+static constexpr bool touchGridMatchesRegions() {
+  for (int gy = 0; gy < TOUCH_GRID_H; gy++) {
+    for (int gx = 0; gx < TOUCH_GRID_W; gx++) {
+      uint8_t cell = touchGrid.cells[gy][gx];
+      if (cell == REGION_MIXED) continue;
+      
+      int x0 = gx * TOUCH_CELL, x1 = x0 + TOUCH_CELL - 1;
+      int y0 = gy * TOUCH_CELL, y1 = y0 + TOUCH_CELL - 1;
+      if (touchRegionAt(x0, y0) != cell || touchRegionAt(x1, y0) != cell ||
+          touchRegionAt(x0, y1) != cell || touchRegionAt(x1, y1) != cell) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static_assert(SCREEN_WIDTH % TOUCH_CELL == 0 && TOUCH_HEIGHT % TOUCH_CELL == 0, "Touch grid must tile the panel");
+static_assert(touchGridMatchesRegions(), "Touch grid disagrees with TOUCH_REGIONS");
+
+static TouchAction classifyTouch(int x, int y) {
+  if (x < 0 || y < 0 || x >= SCREEN_WIDTH || y >= TOUCH_HEIGHT) return TOUCH_NONE;
+  uint8_t region = touchGrid.cells[y >> TOUCH_CELL_SHIFT][x >> TOUCH_CELL_SHIFT];
+  if (region == REGION_MIXED) region = touchRegionAt(x, y);
+  return region == REGION_NONE ? TOUCH_NONE : TOUCH_REGIONS[region].action;
+}
 
 static ButtonState lastButtons;
 static unsigned long lastTouchTime = 0;
 static int lastTouchX = -1, lastTouchY = -1;
+static TouchAction firstTouchAction = TOUCH_NONE;
 static bool hardDropGesture = false;
 
 void initInput() {
@@ -47,13 +108,14 @@ void updateInput() {
         lastTouchX = touch.x;
         lastTouchY = touch.y;
         lastTouchTime = currentTime;
+        firstTouchAction = classifyTouch(touch.x, touch.y);
         hardDropGesture = false;
         return;
       }
       
       unsigned long touchDuration = currentTime - lastTouchTime;
-      int deltaX = touch.x - lastTouchX;
       int deltaY = touch.y - lastTouchY;
+      TouchAction action = classifyTouch(touch.x, touch.y);
       
       // Check for swipe up gesture (hard drop) - keep this
       if (deltaY < -30 && touchDuration < 300) {
@@ -63,42 +125,25 @@ void updateInput() {
           buttons.upPressed = true;
         }
       }
-      else {
-        // Define game field boundaries (with some padding)
-        int gameLeft = OFFSET_X - 5;   // Left edge of game field 
-        int gameRight = OFFSET_X + (FIELD_WIDTH * BLOCK_SIZE) + 5; // Right edge
-        int gameTop = OFFSET_Y - 5;    // Top edge
-        int gameBottom = OFFSET_Y + (FIELD_HEIGHT * BLOCK_SIZE) + 5; // Bottom edge
-        
-        // Check if touch is INSIDE game field
-        bool insideGameField = (touch.x >= gameLeft && touch.x <= gameRight && 
-                               touch.y >= gameTop && touch.y <= gameBottom);
-        
-        if (insideGameField) {
-          // INSIDE game field - TAP = rotate, HOLD = soft drop 
-          if (touchDuration > 300) {
-            // HOLD inside game field = soft drop
-            buttons.down = true;
-          }
-          // TAP handled on release
-        }
-        else {
-          // OUTSIDE game field - move pieces
-          // Left side = move left, Right side = move right
-          if (touch.x < gameLeft) {
-            buttons.left = true;
-          }
-          else if (touch.x > gameRight) {
-            // Make sure we're not hitting the hold button
-            if (!holdButtonZone.inHotZone(touch)) {
-              buttons.right = true;
-            }
-          }
+      else if (action == TOUCH_FIELD) {
+        // INSIDE game field - TAP = rotate, HOLD = soft drop 
+        if (touchDuration > 300) {
+          // HOLD inside game field = soft drop
+          buttons.down = true;
         }
+        // TAP handled on release
+      }
+      // OUTSIDE game field - move pieces
+      // Left side = move left, Right side = move right (hold button excluded)
+      else if (action == TOUCH_LEFT) {
+        buttons.left = true;
+      }
+      else if (action == TOUCH_RIGHT) {
+        buttons.right = true;
       }
       
       // Hold button zone (always works)
-      if (holdButtonZone.inHotZone(touch)) {
+      if (action == TOUCH_HOLD) {
         buttons.btnA = true;
         buttons.btnAPressed = !lastButtons.btnA;
       }
@@ -109,18 +154,8 @@ void updateInput() {
     if (lastTouchX >= 0 && lastTouchY >= 0) {
       unsigned long touchDuration = millis() - lastTouchTime;
       
-      // Define game field boundaries 
-      int gameLeft = OFFSET_X - 5;   
-      int gameRight = OFFSET_X + (FIELD_WIDTH * BLOCK_SIZE) + 5;
-      int gameTop = OFFSET_Y - 5;    
-      int gameBottom = OFFSET_Y + (FIELD_HEIGHT * BLOCK_SIZE) + 5;
-      
-      // Check if tap was INSIDE game field
-      bool insideGameField = (lastTouchX >= gameLeft && lastTouchX <= gameRight && 
-                             lastTouchY >= gameTop && lastTouchY <= gameBottom);
-      
       // Quick TAP inside game field = ROTATE (more sensitive!)
-      if (touchDuration < 150 && !hardDropGesture && insideGameField) {
+      if (touchDuration < 150 && !hardDropGesture && firstTouchAction == TOUCH_FIELD) {
         buttons.joyBtn = true;
         buttons.joyBtnPressed = true;
       }
@@ -4,69 +4,32 @@
 #include "display.h"
 #include "input.h"
 #include "tetris.h"
+#include "movegen.h"
+#include "persist.h"
+#include "telemetry.h"
+#include "audio.h"
+#include "memmon.h"
+#include "soak.h"
+#include "splash_assets.h"
 
-// Tetromino shapes for splash screen
-static const int SHAPES[7][4][2] = {
-  {{0,0}, {1,0}, {2,0}, {3,0}},  // I
-  {{0,0}, {1,0}, {0,1}, {1,1}},  // O
-  {{1,0}, {0,1}, {1,1}, {2,1}},  // T
-  {{0,1}, {1,1}, {1,0}, {2,0}},  // S
-  {{0,0}, {1,0}, {1,1}, {2,1}},  // Z
-  {{0,0}, {1,0}, {2,0}, {2,1}},  // L
-  {{0,0}, {1,0}, {2,0}, {0,1}}   // J
-};
+// Frame time totals for the current game's stats
+static unsigned long long frameTimeTotal = 0;
+static unsigned long frameCount = 0;
+static unsigned long gamesPlayed = 0;
 
-static const uint16_t SPLASH_COLORS[7] = {
-  COLOR_CYAN, COLOR_YELLOW, 0xF81F, COLOR_GREEN, COLOR_RED, COLOR_ORANGE, COLOR_BLUE
-};
-
-// TETRIS letter patterns (5x7 grid)
-static const uint8_t LETTER_T[7] = {0b11111, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100};
-static const uint8_t LETTER_E[7] = {0b11111, 0b10000, 0b10000, 0b11110, 0b10000, 0b10000, 0b11111};
-static const uint8_t LETTER_R[7] = {0b01111, 0b10001, 0b10001, 0b01111, 0b00101, 0b01001, 0b10001};
-static const uint8_t LETTER_I[7] = {0b11111, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100, 0b11111};
-static const uint8_t LETTER_S[7] = {0b01111, 0b10000, 0b10000, 0b01110, 0b00001, 0b00001, 0b11110};
-
-void drawSplashPiece(int x, int y, int type, uint16_t color) {
-  for (int i = 0; i < 4; i++) {
-    int px = SHAPES[type][i][0];
-    int py = SHAPES[type][i][1];
-    int bx = x + px * 8;
-    int by = y + py * 8;
-    M5.Lcd.fillRect(bx, by, 7, 7, color);
-  }
-}
-
-void drawSplashLetter(int x, int y, const uint8_t* letter, uint16_t color) {
-  for (int row = 0; row < 7; row++) {
-    for (int col = 0; col < 5; col++) {
-      if (letter[row] & (1 << (4 - col))) {
-        M5.Lcd.fillRect(x + (col * 4), y + (row * 4), 3, 3, color);
-      }
-    }
-  }
-}
+#if ENABLE_BENCHMARKS
+static unsigned long gameOverAt = 0;  // micros() when the game over path started
+static unsigned long restartAt = 0;   // micros() of the restart touch, 0 once reported
+#endif
 
 void showSplash() {
+#if ENABLE_BENCHMARKS
+  unsigned long drawStart = micros();
+#endif
   clearDisplay();
   
-  // Draw scattered tetris pieces as decoration
-  drawSplashPiece(40, 15, 0, COLOR_CYAN);      // I piece top left
-  drawSplashPiece(250, 18, 1, COLOR_YELLOW);   // O piece top right
-  drawSplashPiece(30, 60, 4, COLOR_RED);       // Z piece left
-  drawSplashPiece(260, 65, 3, COLOR_GREEN);    // S piece right
-  drawSplashPiece(45, 180, 5, COLOR_ORANGE);   // L piece bottom left
-  drawSplashPiece(240, 185, 6, COLOR_BLUE);    // J piece bottom right
-  
-  // Draw TETRIS letters in center - adjusted for M5Core2's 320x240 screen
-  int startX = 80;
-  int startY = 90;
-  drawSplashLetter(startX, startY, LETTER_T, COLOR_CYAN);
-  drawSplashLetter(startX + 25, startY, LETTER_E, COLOR_YELLOW);
-  drawSplashLetter(startX + 50, startY, LETTER_T, COLOR_GREEN);
-  drawSplashLetter(startX + 75, startY, LETTER_R, COLOR_RED);
-  drawSplashLetter(startX + 100, startY, LETTER_I, COLOR_ORANGE);
-  drawSplashLetter(startX + 125, startY, LETTER_S, 0xF81F);  // Magenta
+  // Pieces and TETRIS letters, pre-rasterized from splash_art.h at build time
+  drawRleImage(0, 0, SPLASH_WIDTH, SPLASH_HEIGHT, SPLASH_RLE, COLOR_BLACK);
   
   // Touch instruction
   M5.Lcd.setTextSize(2);
@@ -74,6 +37,11 @@ void showSplash() {
   M5.Lcd.setCursor(85, 150);
   M5.Lcd.print("Touch to play!");
   
+#if ENABLE_BENCHMARKS
+  Serial.printf("splash: drawn in %lu us, interactive %lu ms after boot\n",
+                micros() - drawStart, millis());
+#endif
+  
   // Wait for touch
   while (!M5.Touch.ispressed()) {
     M5.update();
@@ -87,6 +55,39 @@ void showSplash() {
   }
 }
 
+// Queue the finished game for the high score table and flash log.
+// Games with take-backs are practice and don't count.
+void recordFinishedGame() {
+  GameRecord game;
+  unsigned long playTime = tetrisGame.getPlayTime();
+  
+  game.score = tetrisGame.getScore();
+  game.pieces = tetrisGame.getPiecesPlaced();
+  for (int i = 0; i < 4; i++) {
+    game.clears[i] = tetrisGame.getClearCount(i + 1);
+  }
+  game.ppsX100 = playTime > 0 ? (uint32_t)game.pieces * 100000 / playTime : 0;
+  game.avgFrameUs = frameCount > 0 ? frameTimeTotal / frameCount : 0;
+  if (!tetrisGame.isPracticeGame()) recordGame(game);
+  
+  frameTimeTotal = 0;
+  frameCount = 0;
+}
+
+// Stack and heap watermarks after every game
+void reportMemory() {
+  MemorySample mem;
+  memmonSample(mem, ++gamesPlayed);
+#if ENABLE_SOAK
+  if (gamesPlayed % SOAK_REPORT_GAMES != 0) return;
+#endif
+#if ENABLE_TELEMETRY
+  telemetryMemory(mem);
+#else
+  memmonReport(mem);
+#endif
+}
+
 void showGameOver() {
   // Semi-transparent overlay
   M5.Lcd.fillRect(60, 60, 200, 120, 0x2104); // Dark gray
@@ -103,9 +104,17 @@ void showGameOver() {
   M5.Lcd.print("Score: ");
   M5.Lcd.print(tetrisGame.getScore());
   
+  M5.Lcd.setCursor(175, 110);
+  M5.Lcd.print("Best: ");
+  M5.Lcd.print(getHighScore(0));
+  
   M5.Lcd.setCursor(85, 130);
   M5.Lcd.print("Touch to restart");
   
+#if ENABLE_BENCHMARKS
+  Serial.printf("game over: screen up %lu us after the game ended\n", micros() - gameOverAt);
+#endif
+  
   // Wait for touch
   while (!M5.Touch.ispressed()) {
     M5.update();
@@ -117,34 +126,90 @@ void showGameOver() {
     M5.update();
     delay(50);
   }
+#if ENABLE_BENCHMARKS
+  restartAt = micros();
+#endif
   
-  // Clear screen to prevent artifacts
-  clearDisplay();
+  // No clear here: init() sets needsRedraw, and draw() clears once
 }
 
 void setup() {
   M5.begin(true, true, true, true);
   Serial.begin(115200);
   
+  initMemmon();
   initDisplay();
   initInput();
+  memmonWatchTask(xTaskGetCurrentTaskHandle(), "loop");
   
+  initPersist();
+  initAudio();
+  
+#if ENABLE_BENCHMARKS
+  tetrisGame.init();
+  moveGenBenchmark(tetrisGame);
+  tetrisGame.draw();
+  fieldCanvasBenchmark();
+#endif
+  
+#if !ENABLE_SOAK
   showSplash();
+#endif
   
   tetrisGame.init();
+#if !ENABLE_SOAK
+  setPersistPaused(true);  // No flash writes during play
+#endif
+#if ENABLE_TELEMETRY
+  initTelemetry();
+#endif
 }
 
 void loop() {
+#if ENABLE_SOAK
+  soakGame();  // Bot plays instead of input, see soak.cpp
+#else
   M5.update();
   updateInput();
   
   if (!tetrisGame.isGameOver()) {
+    unsigned long frameStart = micros();
     tetrisGame.update();
     tetrisGame.draw();
-  } else {
-    showGameOver();
-    tetrisGame.init(); // Restart game
+    unsigned long frameTime = micros() - frameStart;
+    frameTimeTotal += frameTime;
+    frameCount++;
+#if ENABLE_BENCHMARKS
+    if (restartAt) {
+      Serial.printf("restart: first frame drawn %lu us after the touch\n", micros() - restartAt);
+      restartAt = 0;
+    }
+#endif
+#if ENABLE_TELEMETRY
+    telemetryTick(tetrisGame, frameTime);
+#endif
+    delay(16); // ~60 FPS
+    return;
   }
-  
-  delay(16); // ~60 FPS
-}
\ No newline at end of file
+#endif
+  
+  // Game over, for players and the soak bot alike
+#if ENABLE_BENCHMARKS
+  gameOverAt = micros();
+#endif
+#if ENABLE_TELEMETRY
+  telemetryGameOver(tetrisGame);
+#endif
+  setPersistPaused(false);  // Flash writes stall both cores, so only between games
+  recordFinishedGame();
+  reportMemory();
+#if !ENABLE_SOAK
+  showGameOver();          // The soak bot restarts straight away
+  setPersistPaused(true);  // and has no frames to protect
+#endif
+  tetrisGame.init(); // Restart game
+#if ENABLE_TELEMETRY
+  telemetryStartGame();
+#endif
+  delay(1);  // Let the idle task and watchdog run
+}
@@ -0,0 +1,64 @@
+// memmon.cpp - Stack and heap watermarks for M5Core2 Tetris
+#include "memmon.h"
+#include <esp_heap_caps.h>
+
+static TaskHandle_t watchedTasks[MEMMON_MAX_TASKS];
+static const char* watchedNames[MEMMON_MAX_TASKS];
+static int watchedCount = 0;
+static volatile uint32_t failedAllocs = 0;
+static uint32_t baselineHeap = 0;
+
+// Called by the allocator from whichever task failed
+static void onFailedAlloc(size_t size, uint32_t caps, const char* function) {
+  failedAllocs++;
+}
+
+void initMemmon() {
+  heap_caps_register_failed_alloc_callback(onFailedAlloc);
+}
+
+void memmonWatchTask(TaskHandle_t task, const char* name) {
+  if (task == NULL || watchedCount >= MEMMON_MAX_TASKS) return;
+  watchedTasks[watchedCount] = task;
+  watchedNames[watchedCount] = name;
+  watchedCount++;
+}
+
+void memmonSample(MemorySample& sample, uint32_t game) {
+  sample.game = game;
+  sample.uptime = millis() / 1000;
+  sample.freeHeap = ESP.getFreeHeap();
+  sample.minFreeHeap = ESP.getMinFreeHeap();
+  sample.largestBlock = ESP.getMaxAllocHeap();
+  sample.fragmentation = sample.freeHeap > 0 ?
+    100 - (uint64_t)sample.largestBlock * 100 / sample.freeHeap : 0;
+  
+  multi_heap_info_t info;
+  heap_caps_get_info(&info, MALLOC_CAP_8BIT);
+  sample.allocatedBlocks = info.allocated_blocks;
+  sample.failedAllocs = failedAllocs;
+  
+  if (baselineHeap == 0) baselineHeap = sample.freeHeap;
+  sample.heapDrift = (int32_t)sample.freeHeap - (int32_t)baselineHeap;
+  
+  // On the ESP32 the high-water mark is already in bytes
+  sample.taskCount = watchedCount;
+  for (int i = 0; i < watchedCount; i++) {
+    sample.stackFree[i] = uxTaskGetStackHighWaterMark(watchedTasks[i]);
+    sample.taskName[i] = watchedNames[i];
+  }
+}
+
+void memmonReport(const MemorySample& sample) {
+  Serial.printf("MEM game=%lu up=%lus heap=%lu min=%lu largest=%lu frag=%u%% "
+                "blocks=%lu failed=%lu drift=%ld stack",
+                (unsigned long)sample.game, (unsigned long)sample.uptime,
+                (unsigned long)sample.freeHeap, (unsigned long)sample.minFreeHeap,
+                (unsigned long)sample.largestBlock, sample.fragmentation,
+                (unsigned long)sample.allocatedBlocks, (unsigned long)sample.failedAllocs,
+                (long)sample.heapDrift);
+  for (int i = 0; i < sample.taskCount; i++) {
+    Serial.printf(" %s=%u", sample.taskName[i], sample.stackFree[i]);
+  }
+  Serial.println();
+}
@@ -0,0 +1,29 @@
+// memmon.h - Stack and heap watermarks for M5Core2 Tetris
+#ifndef MEMMON_H
+#define MEMMON_H
+
+#include "config.h"
+
+#define MEMMON_MAX_TASKS 4
+
+struct MemorySample {
+  uint32_t game;            // Games finished when sampled
+  uint32_t uptime;          // Seconds
+  uint32_t freeHeap;
+  uint32_t minFreeHeap;     // Lowest free heap since boot
+  uint32_t largestBlock;    // Biggest single allocation possible
+  uint8_t fragmentation;    // % of free heap outside the largest block
+  uint32_t allocatedBlocks; // Live heap allocations; should level off
+  uint32_t failedAllocs;    // Allocations refused since boot
+  int32_t heapDrift;        // Free heap change since the first sample
+  uint8_t taskCount;
+  uint16_t stackFree[MEMMON_MAX_TASKS];  // Bytes of stack never touched
+  const char* taskName[MEMMON_MAX_TASKS];
+};
+
+void initMemmon();  // Before anything allocates, to count failures
+void memmonWatchTask(TaskHandle_t task, const char* name);
+void memmonSample(MemorySample& sample, uint32_t game);
+void memmonReport(const MemorySample& sample);  // One text line on Serial
+
+#endif
@@ -0,0 +1,199 @@
+// movegen.cpp - Reachable placement generator for M5Core2 Tetris
+#include "movegen.h"
+
+#define FULL_ROW ((1 << FIELD_WIDTH) - 1)
+
+// State index layout: ((y * FIELD_WIDTH) + x) * 4 + rot
+#define STATE_INDEX(x, y, rot) ((((y) * FIELD_WIDTH) + (x)) * 4 + (rot))
+
+void MoveGenerator::load(TetrisGame& game) {
+  for (int y = 0; y < FIELD_HEIGHT; y++) {
+    rows[y] = 0;
+    for (int x = 0; x < FIELD_WIDTH; x++) {
+      if (game.field[y][x] > 0) rows[y] |= 1 << x;
+    }
+  }
+  
+  for (int p = 0; p < 7; p++) {
+    for (int r = 0; r < 4; r++) {
+      for (int i = 0; i < 4; i++) {
+        cellY[p][r][i] = game.pieces[p][r][0][i];
+        cellX[p][r][i] = game.pieces[p][r][1][i];
+      }
+    }
+  }
+  
+  nodes = 0;
+}
+
+// Same rules as TetrisGame::test(): walls and floor block, above the top is open
+bool MoveGenerator::collides(int y, int x, int piece, int rot) {
+  for (int i = 0; i < 4; i++) {
+    int px = x + cellX[piece][rot][i];
+    int py = y + cellY[piece][rot][i];
+    
+    if (px < 0 || px >= FIELD_WIDTH || py >= FIELD_HEIGHT) return true;
+    if (py >= 0 && (rows[py] & (1 << px))) return true;
+  }
+  return false;
+}
+
+// Sorted cell indices packed into 32 bits, so symmetric rotations that
+// cover the same cells count as one placement
+uint32_t MoveGenerator::cellKey(int y, int x, int piece, int rot) {
+  uint8_t cells[4];
+  for (int i = 0; i < 4; i++) {
+    int px = x + cellX[piece][rot][i];
+    int py = y + cellY[piece][rot][i] + 2;  // Pieces may poke above row 0
+    cells[i] = py * FIELD_WIDTH + px;
+  }
+  for (int i = 1; i < 4; i++) {
+    uint8_t c = cells[i];
+    int j = i - 1;
+    while (j >= 0 && cells[j] > c) {
+      cells[j + 1] = cells[j];
+      j--;
+    }
+    cells[j + 1] = c;
+  }
+  return ((uint32_t)cells[0] << 24) | ((uint32_t)cells[1] << 16) | (cells[2] << 8) | cells[3];
+}
+
+int MoveGenerator::generate(int piece, Placement* out, int maxOut) {
+  uint32_t keys[MAX_PLACEMENTS];
+  int count = 0;
+  int head = 0, tail = 0;
+  
+  if (maxOut > MAX_PLACEMENTS) maxOut = MAX_PLACEMENTS;
+  memset(visited, 0, sizeof(visited));
+  
+  // Spawn exactly where newPiece() puts it
+  int spawnX = FIELD_WIDTH / 2 - 1;
+  if (collides(0, spawnX, piece, 0)) return 0;
+  
+  int start = STATE_INDEX(spawnX, 0, 0);
+  visited[start >> 3] |= 1 << (start & 7);
+  queue[tail++] = start;
+  
+  while (head < tail) {
+    int state = queue[head++];
+    int rot = state & 3;
+    int x = (state >> 2) % FIELD_WIDTH;
+    int y = (state >> 2) / FIELD_WIDTH;
+    nodes++;
+    
+    // Resting on something - this is a lockable placement
+    if (collides(y + 1, x, piece, rot)) {
+      uint32_t key = cellKey(y, x, piece, rot);
+      bool seen = false;
+      for (int i = 0; i < count; i++) {
+        if (keys[i] == key) {
+          seen = true;
+          break;
+        }
+      }
+      if (!seen && count < maxOut) {
+        keys[count] = key;
+        out[count].x = x;
+        out[count].y = y;
+        out[count].rot = rot;
+        out[count].piece = piece;
+        count++;
+      }
+    }
+    
+    // Left, right, rotate clockwise, soft drop
+    int nx[4] = {x - 1, x + 1, x, x};
+    int ny[4] = {y, y, y, y + 1};
+    int nr[4] = {rot, rot, (rot + 1) % 4, rot};
+    for (int m = 0; m < 4; m++) {
+      if (nx[m] < 0 || nx[m] >= FIELD_WIDTH || ny[m] >= FIELD_HEIGHT) continue;
+      int next = STATE_INDEX(nx[m], ny[m], nr[m]);
+      if (visited[next >> 3] & (1 << (next & 7))) continue;
+      visited[next >> 3] |= 1 << (next & 7);
+      if (collides(ny[m], nx[m], piece, nr[m])) continue;
+      queue[tail++] = next;
+    }
+  }
+  
+  return count;
+}
+
+// Mirrors placePiece() followed by clearLines()
+void MoveGenerator::lock(const Placement& p) {
+  for (int i = 0; i < 4; i++) {
+    int px = p.x + cellX[p.piece][p.rot][i];
+    int py = p.y + cellY[p.piece][p.rot][i];
+    if (py >= 0 && py < FIELD_HEIGHT) rows[py] |= 1 << px;
+  }
+  
+  int dst = FIELD_HEIGHT - 1;
+  for (int y = FIELD_HEIGHT - 1; y >= 0; y--) {
+    if (rows[y] != FULL_ROW) rows[dst--] = rows[y];
+  }
+  while (dst >= 0) rows[dst--] = 0;
+}
+
+// Number of placement sequences for the given pieces, perft style.
+// A top-out (spawn blocked) ends that branch early.
+unsigned long MoveGenerator::perft(const uint8_t* sequence, int depth) {
+  if (depth == 0) return 1;
+  
+  Placement moves[MAX_PLACEMENTS];
+  int count = generate(sequence[0], moves, MAX_PLACEMENTS);
+  if (depth == 1) return count;
+  
+  uint16_t saved[FIELD_HEIGHT];
+  memcpy(saved, rows, sizeof(rows));
+  
+  unsigned long total = 0;
+  for (int i = 0; i < count; i++) {
+    lock(moves[i]);
+    total += perft(sequence + 1, depth - 1);
+    memcpy(rows, saved, sizeof(rows));
+  }
+  return total;
+}
+
+// Simple bot cost after locking p: stack height plus heavily weighted
+// holes. Lower is better. The field is left unchanged.
+int MoveGenerator::evaluate(const Placement& p) {
+  uint16_t saved[FIELD_HEIGHT];
+  uint16_t covered = 0;
+  int height = 0, holes = 0;
+  
+  memcpy(saved, rows, sizeof(rows));
+  lock(p);
+  for (int y = 0; y < FIELD_HEIGHT; y++) {
+    if (rows[y] && height == 0) height = FIELD_HEIGHT - y;
+    holes += __builtin_popcount(covered & ~rows[y]);
+    covered |= rows[y];
+  }
+  memcpy(rows, saved, sizeof(rows));
+  
+  return height + holes * 4;
+}
+
+#if ENABLE_BENCHMARKS
+// Fixed piece sequence (O, I, T) and its known leaf counts on the empty
+// field, so a run doubles as a correctness check. test/host checks deeper.
+static const uint8_t PERFT_SEQUENCE[] = {0, 1, 2};
+static const unsigned long PERFT_EXPECTED[] = {11, 231, 9898};
+#define PERFT_DEPTH 3
+
+void moveGenBenchmark(TetrisGame& game) {
+  static MoveGenerator gen;  // Too big for the loop task stack
+  
+  for (int depth = 1; depth <= PERFT_DEPTH; depth++) {
+    gen.load(game);
+    unsigned long start = micros();
+    unsigned long leaves = gen.perft(PERFT_SEQUENCE, depth);
+    unsigned long elapsed = micros() - start;
+    
+    Serial.printf("perft(%d): %lu placements (%s), %lu nodes, %lu us, %lu nodes/s\n",
+                  depth, leaves, leaves == PERFT_EXPECTED[depth - 1] ? "ok" : "MISMATCH",
+                  gen.nodes, elapsed,
+                  elapsed > 0 ? (unsigned long)((uint64_t)gen.nodes * 1000000 / elapsed) : 0);
+  }
+}
+#endif
@@ -0,0 +1,49 @@
+// movegen.h - Reachable placement generator for M5Core2 Tetris
+#ifndef MOVEGEN_H
+#define MOVEGEN_H
+
+#include "tetris.h"
+
+#define MAX_PLACEMENTS 128    // Per piece; real fields stay well below this
+#define MOVEGEN_STATES (FIELD_WIDTH * FIELD_HEIGHT * 4)
+
+// A lockable resting spot for a piece (same x/y/rot meaning as TetrisGame)
+struct Placement {
+  int8_t x;
+  int8_t y;
+  int8_t rot;
+  int8_t piece;
+};
+
+// Breadth-first search over (x, y, rotation) using the game's own rules:
+// shift left/right, rotate clockwise (no kicks, like handleInput()) and
+// soft drop. Input timing is ignored, so tucks and spins count as long as
+// the moves exist. Works on a row-bitmask copy of the field.
+class MoveGenerator {
+public:
+  void load(TetrisGame& game);
+  int generate(int piece, Placement* out, int maxOut);
+  unsigned long perft(const uint8_t* sequence, int depth);
+  int evaluate(const Placement& p);
+  
+  unsigned long nodes;  // States expanded since load(), for benchmarking
+  
+private:
+  uint16_t rows[FIELD_HEIGHT];
+  int8_t cellX[7][4][4];
+  int8_t cellY[7][4][4];
+  
+  // Transposition table: one bit per (x, y, rot) state
+  uint8_t visited[(MOVEGEN_STATES + 7) / 8];
+  uint16_t queue[MOVEGEN_STATES];
+  
+  bool collides(int y, int x, int piece, int rot);
+  uint32_t cellKey(int y, int x, int piece, int rot);
+  void lock(const Placement& p);
+};
+
+#if ENABLE_BENCHMARKS
+void moveGenBenchmark(TetrisGame& game);
+#endif
+
+#endif
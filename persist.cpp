@@ -0,0 +1,233 @@
+// persist.cpp - High scores and session stats saved to flash for M5Core2 Tetris
+//
+// The frame loop only pushes records into a RAM ring. A low priority task
+// drains the ring and appends the records to a log file in SPIFFS. A flash
+// write disables the cache on both cores, so running on core 0 does not
+// keep it off the loop: the task only writes while persistence is unpaused,
+// i.e. between games. Each record carries a CRC, so a slot torn or
+// corrupted by a power cut is skipped at the next boot.
+#include "persist.h"
+#include "spsc_ring.h"
+#include "memmon.h"
+#include <SPIFFS.h>
+#include <stddef.h>
+#include <atomic>
+
+#define RECORD_MAGIC 0x5445      // "TE"
+#define RECORD_GAME 1
+
+struct PersistRecord {
+  uint16_t magic;
+  uint8_t type;
+  uint8_t length;
+  uint32_t sequence;
+  uint8_t payload[20];
+  uint32_t crc;                  // CRC-32 of everything above
+};
+
+static_assert(sizeof(GameRecord) <= sizeof(((PersistRecord*)0)->payload), "GameRecord too big");
+static_assert(sizeof(PersistRecord) == 32, "PersistRecord must stay 32 bytes");
+
+static SpscRing<PersistRecord, PERSIST_RING_SIZE> pending;
+static TaskHandle_t flushTaskHandle = NULL;
+static std::atomic<bool> paused(false);
+static uint32_t nextSequence = 0;
+static uint32_t droppedRecords = 0;
+static bool storageReady = false;
+static int highScores[HIGH_SCORE_COUNT];
+
+// Owned by the flush task (and loadLog() before it starts): the records
+// behind the high score table, kept whole so compaction can copy them
+static PersistRecord bestRecords[HIGH_SCORE_COUNT];
+static int bestCount = 0;
+static uint32_t logRecords = 0;  // 32-byte slots in the log file
+
+static uint32_t crc32(const uint8_t* data, size_t length) {
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < length; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+    }
+  }
+  return ~crc;
+}
+
+static bool recordValid(const PersistRecord& rec) {
+  return rec.magic == RECORD_MAGIC &&
+         rec.length <= sizeof(rec.payload) &&
+         rec.crc == crc32((const uint8_t*)&rec, offsetof(PersistRecord, crc));
+}
+
+static void insertHighScore(int score) {
+  for (int i = 0; i < HIGH_SCORE_COUNT; i++) {
+    if (score > highScores[i]) {
+      for (int j = HIGH_SCORE_COUNT - 1; j > i; j--) {
+        highScores[j] = highScores[j - 1];
+      }
+      highScores[i] = score;
+      return;
+    }
+  }
+}
+
+static void makeGameRecord(PersistRecord& rec, const GameRecord& game) {
+  memset(&rec, 0, sizeof(rec));
+  rec.magic = RECORD_MAGIC;
+  rec.type = RECORD_GAME;
+  rec.length = sizeof(GameRecord);
+  rec.sequence = nextSequence++;
+  memcpy(rec.payload, &game, sizeof(GameRecord));
+  rec.crc = crc32((const uint8_t*)&rec, offsetof(PersistRecord, crc));
+}
+
+static int32_t recordScore(const PersistRecord& rec) {
+  GameRecord game;
+  memcpy(&game, rec.payload, sizeof(game));
+  return game.score;
+}
+
+static void insertBestRecord(const PersistRecord& rec) {
+  int32_t score = recordScore(rec);
+  for (int i = 0; i < HIGH_SCORE_COUNT; i++) {
+    if (i >= bestCount || score > recordScore(bestRecords[i])) {
+      memmove(&bestRecords[i + 1], &bestRecords[i],
+              (HIGH_SCORE_COUNT - 1 - i) * sizeof(PersistRecord));
+      bestRecords[i] = rec;
+      if (bestCount < HIGH_SCORE_COUNT) bestCount++;
+      return;
+    }
+  }
+}
+
+// Rewrite the log with just the high score games. The new log is written
+// beside the old one and swapped in, so a power cut leaves one of them.
+// A game starting part way through abandons the new log; the old one is
+// still whole and the next flush starts over.
+static void compactLog() {
+  File file = SPIFFS.open(PERSIST_TEMP_FILE, FILE_WRITE);
+  if (!file) return;
+  for (int i = 0; i < bestCount; i++) {
+    if (paused) {
+      file.close();
+      SPIFFS.remove(PERSIST_TEMP_FILE);
+      return;
+    }
+    file.write((const uint8_t*)&bestRecords[i], sizeof(PersistRecord));
+  }
+  file.close();
+  
+  SPIFFS.remove(PERSIST_FILE);
+  SPIFFS.rename(PERSIST_TEMP_FILE, PERSIST_FILE);
+  logRecords = bestCount;
+}
+
+// Boot only: rebuild the high score table from the log. Bad slots are
+// skipped; compact if any turned up, the tail was torn or the log is long.
+static void loadLog() {
+  PersistRecord rec;
+  bool damaged = false;
+  size_t length;
+  
+  // A cut during compaction can leave only the new log
+  if (!SPIFFS.exists(PERSIST_FILE) && SPIFFS.exists(PERSIST_TEMP_FILE)) {
+    SPIFFS.rename(PERSIST_TEMP_FILE, PERSIST_FILE);
+  }
+  
+  File file = SPIFFS.open(PERSIST_FILE, FILE_READ);
+  if (!file) return;
+  
+  length = file.size();
+  logRecords = length / sizeof(rec);
+  if (length % sizeof(rec) != 0) damaged = true;  // Torn final record
+  
+  for (uint32_t i = 0; i < logRecords; i++) {
+    if (file.read((uint8_t*)&rec, sizeof(rec)) != sizeof(rec)) break;
+    if (!recordValid(rec)) {
+      damaged = true;  // Slots are fixed size, so the next one is still good
+      continue;
+    }
+    if (rec.sequence >= nextSequence) nextSequence = rec.sequence + 1;
+    if (rec.type == RECORD_GAME) insertBestRecord(rec);
+  }
+  file.close();
+  
+  for (int i = 0; i < bestCount; i++) {
+    highScores[i] = recordScore(bestRecords[i]);
+  }
+  
+  if (damaged || logRecords > PERSIST_MAX_RECORDS) {
+    compactLog();
+  }
+}
+
+// Runs on the flush task only. Stops as soon as a game starts; whatever
+// is left goes out at the next game over.
+static void flushPending() {
+  PersistRecord rec;
+  
+  if (pending.count() > 0) {
+    File file = SPIFFS.open(PERSIST_FILE, FILE_APPEND);
+    if (!file) return;
+    while (!paused && pending.pop(rec)) {
+      file.write((const uint8_t*)&rec, sizeof(rec));
+      logRecords++;
+      if (rec.type == RECORD_GAME) insertBestRecord(rec);
+    }
+    file.close();
+  }
+  
+  // Also retries a compaction that an earlier game start cut short
+  if (!paused && logRecords > PERSIST_MAX_RECORDS) {
+    compactLog();
+  }
+}
+
+static void flushTask(void* param) {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    if (!paused) flushPending();
+  }
+}
+
+void initPersist() {
+  memset(highScores, 0, sizeof(highScores));
+  
+  storageReady = SPIFFS.begin(true);  // Format on first boot
+  if (!storageReady) return;
+  
+  loadLog();
+  
+  xTaskCreatePinnedToCore(flushTask, "persist", 4096, NULL, 1, &flushTaskHandle, 0);
+  memmonWatchTask(flushTaskHandle, "persist");
+}
+
+void recordGame(const GameRecord& game) {
+  PersistRecord rec;
+  
+  insertHighScore(game.score);
+  if (!storageReady) return;
+  
+  makeGameRecord(rec, game);
+  if (!pending.push(rec)) {
+    droppedRecords++;
+    return;
+  }
+  
+  // Game over: write it while the player looks at the score
+  xTaskNotifyGive(flushTaskHandle);
+}
+
+void setPersistPaused(bool pause) {
+  paused = pause;
+  if (!pause && flushTaskHandle) xTaskNotifyGive(flushTaskHandle);
+}
+
+int getHighScore(int rank) {
+  if (rank < 0 || rank >= HIGH_SCORE_COUNT) return 0;
+  return highScores[rank];
+}
+
+uint32_t getDroppedRecords() {
+  return droppedRecords;
+}
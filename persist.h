@@ -0,0 +1,28 @@
+// persist.h - High scores and session stats saved to flash for M5Core2 Tetris
+#ifndef PERSIST_H
+#define PERSIST_H
+
+#include "config.h"
+
+#define HIGH_SCORE_COUNT 5
+#define PERSIST_RING_SIZE 16        // Records waiting for the flush task
+#define PERSIST_MAX_RECORDS 512     // Compact the log past this many records
+#define PERSIST_FILE "/tetris.log"
+#define PERSIST_TEMP_FILE "/tetris.tmp"  // Compaction output before the rename
+
+// One finished game; exactly fills a log record payload
+struct GameRecord {
+  int32_t score;
+  uint32_t pieces;
+  uint16_t clears[4];     // Singles, doubles, triples, tetrises
+  uint16_t ppsX100;       // Pieces per second * 100
+  uint16_t avgFrameUs;    // Average update + draw time
+};
+
+void initPersist();
+void recordGame(const GameRecord& game);  // Never blocks on flash
+void setPersistPaused(bool paused);       // No flash writes while true (in play)
+int getHighScore(int rank);               // 0 if that rank is empty
+uint32_t getDroppedRecords();
+
+#endif
@@ -0,0 +1,142 @@
+// rewind.cpp - Per-piece rewind history for M5Core2 Tetris
+//
+// Entry layout: flags, 3 byte row mask (deltas only), changed rows, then
+// piece, held, next, canHold, score, lines, pieces, level.
+#include "rewind.h"
+
+RewindBuffer rewindBuffer;
+
+#define ENTRY_KEY 0x01
+#define META_BYTES 21
+#define MAX_ENTRY_BYTES (1 + 3 + FIELD_HEIGHT * FIELD_ROW_BYTES + META_BYTES)
+
+static_assert(REWIND_BYTES <= 65535, "offsets are 16 bit");
+
+void RewindBuffer::clear() {
+  first = 0;
+  entries = 0;
+  bytesUsed = 0;
+  sinceKey = 0;
+}
+
+void RewindBuffer::dropOldest() {
+  // Deltas without their keyframe are useless, so drop the whole group
+  do {
+    bytesUsed -= lengths[first];
+    first = (first + 1) % REWIND_MAX_ENTRIES;
+    entries--;
+  } while (entries > 0 && !keyframe[first]);
+}
+
+void RewindBuffer::push(const RewindState& state) {
+  uint8_t entry[MAX_ENTRY_BYTES];
+  int length = 0;
+  
+  bool key = entries == 0 || sinceKey >= REWIND_KEY_INTERVAL;
+  uint32_t mask = 0;
+  for (int y = 0; y < FIELD_HEIGHT; y++) {
+    if (key || memcmp(state.rows[y], last.rows[y], FIELD_ROW_BYTES) != 0) mask |= 1UL << y;
+  }
+  
+  entry[length++] = key ? ENTRY_KEY : 0;
+  if (!key) {
+    entry[length++] = mask & 0xFF;
+    entry[length++] = (mask >> 8) & 0xFF;
+    entry[length++] = (mask >> 16) & 0xFF;
+  }
+  for (int y = 0; y < FIELD_HEIGHT; y++) {
+    if (!(mask & (1UL << y))) continue;
+    memcpy(&entry[length], state.rows[y], FIELD_ROW_BYTES);
+    length += FIELD_ROW_BYTES;
+  }
+  memcpy(&entry[length], &state.currentPiece, 4);
+  memcpy(&entry[length + 4], &state.score, 4);
+  memcpy(&entry[length + 8], &state.linesCleared, 2);
+  memcpy(&entry[length + 10], &state.piecesPlaced, 2);
+  memcpy(&entry[length + 12], state.clearCounts, 8);
+  entry[length + 20] = state.level;
+  length += META_BYTES;
+  
+  // Make room; if that empties the ring this entry must become a keyframe
+  while (entries > 0 && (entries == REWIND_MAX_ENTRIES || bytesUsed + length > REWIND_BYTES)) {
+    dropOldest();
+  }
+  if (entries == 0 && !key) {
+    clear();
+    push(state);
+    return;
+  }
+  
+  int s = slot(entries);
+  int offset = entries > 0 ? (offsets[slot(entries - 1)] + lengths[slot(entries - 1)]) % REWIND_BYTES : 0;
+  offsets[s] = offset;
+  lengths[s] = length;
+  keyframe[s] = key;
+  for (int i = 0; i < length; i++) {
+    ring[(offset + i) % REWIND_BYTES] = entry[i];
+  }
+  
+  entries++;
+  bytesUsed += length;
+  sinceKey = key ? 1 : sinceKey + 1;
+  last = state;
+}
+
+// Apply one entry on top of state (keyframes overwrite every row)
+void RewindBuffer::decode(int index, RewindState& state) {
+  int s = slot(index);
+  int pos = offsets[s];
+  uint8_t entry[MAX_ENTRY_BYTES];
+  
+  for (int i = 0; i < lengths[s]; i++) {
+    entry[i] = ring[(pos + i) % REWIND_BYTES];
+  }
+  
+  int length = 1;
+  uint32_t mask = (1UL << FIELD_HEIGHT) - 1;
+  if (!(entry[0] & ENTRY_KEY)) {
+    mask = entry[1] | (entry[2] << 8) | ((uint32_t)entry[3] << 16);
+    length = 4;
+  }
+  for (int y = 0; y < FIELD_HEIGHT; y++) {
+    if (!(mask & (1UL << y))) continue;
+    memcpy(state.rows[y], &entry[length], FIELD_ROW_BYTES);
+    length += FIELD_ROW_BYTES;
+  }
+  memcpy(&state.currentPiece, &entry[length], 4);
+  memcpy(&state.score, &entry[length + 4], 4);
+  memcpy(&state.linesCleared, &entry[length + 8], 2);
+  memcpy(&state.piecesPlaced, &entry[length + 10], 2);
+  memcpy(state.clearCounts, &entry[length + 12], 8);
+  state.level = entry[length + 20];
+}
+
+// 0 is the newest entry, 1 the piece before it, and so on
+bool RewindBuffer::seek(int piecesBack, RewindState& out) {
+  int target = entries - 1 - piecesBack;
+  if (piecesBack < 0 || target < 0) return false;
+  
+  int start = target;
+  while (!keyframe[slot(start)]) start--;
+  for (int i = start; i <= target; i++) {
+    decode(i, out);
+  }
+  return true;
+}
+
+bool RewindBuffer::rewind(int piecesBack, RewindState& out) {
+  if (!seek(piecesBack, out)) return false;
+  
+  // Newer entries go; the key counter restarts from the target's group
+  for (int i = 0; i < piecesBack; i++) {
+    entries--;
+    bytesUsed -= lengths[slot(entries)];
+  }
+  sinceKey = 0;
+  for (int i = entries - 1; i >= 0; i--) {
+    sinceKey++;
+    if (keyframe[slot(i)]) break;
+  }
+  last = out;
+  return true;
+}
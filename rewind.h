@@ -0,0 +1,56 @@
+// rewind.h - Per-piece rewind history for M5Core2 Tetris
+#ifndef REWIND_H
+#define REWIND_H
+
+#include "tetris.h"
+
+#define FIELD_ROW_BYTES (FIELD_WIDTH / 2)  // One nibble per cell
+#define REWIND_BYTES 4096             // Hard cap on encoded history
+#define REWIND_MAX_ENTRIES 64         // Pieces of history at most
+#define REWIND_KEY_INTERVAL 8         // Full snapshot every N pieces
+
+// Everything needed to resume play at a piece spawn
+struct RewindState {
+  uint8_t rows[FIELD_HEIGHT][FIELD_ROW_BYTES];  // Packed field, row 0 at the top
+  int8_t currentPiece;
+  int8_t heldPiece;
+  int8_t nextPiece;
+  uint8_t canHold;
+  int32_t score;
+  uint16_t linesCleared;
+  uint16_t piecesPlaced;
+  uint16_t clearCounts[4];  // Singles, doubles, triples, tetrises
+  uint8_t level;
+};
+
+// Entries are keyframes (every row) or deltas (changed rows only) against
+// the entry before, packed into one fixed byte ring. Pushing is O(1)
+// amortized; when full the oldest keyframe group is dropped. Seeking back
+// decodes at most REWIND_KEY_INTERVAL entries.
+class RewindBuffer {
+public:
+  void clear();
+  void push(const RewindState& state);
+  bool seek(int piecesBack, RewindState& out);
+  bool rewind(int piecesBack, RewindState& out);  // seek() and forget newer entries
+  int count() { return entries; }
+  
+private:
+  uint8_t ring[REWIND_BYTES];
+  uint16_t offsets[REWIND_MAX_ENTRIES];
+  uint16_t lengths[REWIND_MAX_ENTRIES];
+  bool keyframe[REWIND_MAX_ENTRIES];
+  int first;          // Oldest entry slot
+  int entries;
+  int bytesUsed;
+  int sinceKey;
+  RewindState last;   // Newest state, base for the next delta
+  
+  int slot(int index) { return (first + index) % REWIND_MAX_ENTRIES; }
+  void dropOldest();
+  void decode(int index, RewindState& state);
+};
+
+extern RewindBuffer rewindBuffer;
+
+#endif
@@ -0,0 +1,35 @@
+// soak.cpp - Headless bot games for long-run memory testing
+//
+// With ENABLE_SOAK set, loop() lets the bot play each game instead of
+// reading input, then goes through the same game over path as real play:
+// recordGame(), reportMemory(), the overlay and tetrisGame.init(), with the
+// persist and audio tasks running. Heap drift and live block counts in the
+// memory reports show slow leaks over days.
+#include "soak.h"
+#include "tetris.h"
+#include "movegen.h"
+
+static MoveGenerator gen;
+
+void soakGame() {
+  Placement moves[MAX_PLACEMENTS];
+  
+  for (int n = 0; n < SOAK_MAX_PIECES && !tetrisGame.isGameOver(); n++) {
+    gen.load(tetrisGame);
+    int count = gen.generate(tetrisGame.getCurrentPiece(), moves, MAX_PLACEMENTS);
+    if (count == 0) break;
+    
+    int best = 0;
+    int bestCost = gen.evaluate(moves[0]);
+    for (int i = 1; i < count; i++) {
+      int cost = gen.evaluate(moves[i]);
+      if (cost < bestCost) {
+        best = i;
+        bestCost = cost;
+      }
+    }
+    tetrisGame.lockAt(moves[best].x, moves[best].y, moves[best].rot);
+  }
+  tetrisGame.endGame();  // Survivors stop at SOAK_MAX_PIECES
+  tetrisGame.draw();
+}
@@ -0,0 +1,12 @@
+// soak.h - Headless bot games for long-run memory testing
+#ifndef SOAK_H
+#define SOAK_H
+
+#include "config.h"
+
+#define SOAK_MAX_PIECES 1000    // End a game here even if the bot survives
+#define SOAK_REPORT_GAMES 100   // Memory report interval
+
+void soakGame();  // Bot plays tetrisGame until it is over
+
+#endif
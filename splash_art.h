@@ -0,0 +1,61 @@
+// splash_art.h - Splash screen artwork for M5Core2 Tetris
+//
+// Not compiled into the game: tools/gen_splash_assets.py rasterizes these
+// tables into splash_assets.h before every build. Keep the same simple
+// layout so the script can read them.
+#ifndef SPLASH_ART_H
+#define SPLASH_ART_H
+
+#include "config.h"
+
+// Tetromino shapes for splash screen
+static const int SHAPES[7][4][2] = {
+  {{0,0}, {1,0}, {2,0}, {3,0}},  // I
+  {{0,0}, {1,0}, {0,1}, {1,1}},  // O
+  {{1,0}, {0,1}, {1,1}, {2,1}},  // T
+  {{0,1}, {1,1}, {1,0}, {2,0}},  // S
+  {{0,0}, {1,0}, {1,1}, {2,1}},  // Z
+  {{0,0}, {1,0}, {2,0}, {2,1}},  // L
+  {{0,0}, {1,0}, {2,0}, {0,1}}   // J
+};
+
+// TETRIS letter patterns (5x7 grid)
+static const uint8_t LETTER_T[7] = {0b11111, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100};
+static const uint8_t LETTER_E[7] = {0b11111, 0b10000, 0b10000, 0b11110, 0b10000, 0b10000, 0b11111};
+static const uint8_t LETTER_R[7] = {0b01111, 0b10001, 0b10001, 0b01111, 0b00101, 0b01001, 0b10001};
+static const uint8_t LETTER_I[7] = {0b11111, 0b00100, 0b00100, 0b00100, 0b00100, 0b00100, 0b11111};
+static const uint8_t LETTER_S[7] = {0b01111, 0b10000, 0b10000, 0b01110, 0b00001, 0b00001, 0b11110};
+
+// Pieces are 8px cells drawn 7x7; letters are 4px cells drawn 3x3
+struct SplashPiece {
+  int x, y, type;
+  uint16_t color;
+};
+
+struct SplashLetter {
+  int x, y;
+  const uint8_t* glyph;
+  uint16_t color;
+};
+
+// Scattered tetris pieces as decoration
+static const SplashPiece SPLASH_PIECES[] = {
+  {40, 15, 0, COLOR_CYAN},      // I piece top left
+  {250, 18, 1, COLOR_YELLOW},   // O piece top right
+  {30, 60, 4, COLOR_RED},       // Z piece left
+  {260, 65, 3, COLOR_GREEN},    // S piece right
+  {45, 180, 5, COLOR_ORANGE},   // L piece bottom left
+  {240, 185, 6, COLOR_BLUE}     // J piece bottom right
+};
+
+// TETRIS letters in center
+static const SplashLetter SPLASH_LETTERS[] = {
+  {80, 90, LETTER_T, COLOR_CYAN},
+  {105, 90, LETTER_E, COLOR_YELLOW},
+  {130, 90, LETTER_T, COLOR_GREEN},
+  {155, 90, LETTER_R, COLOR_RED},
+  {180, 90, LETTER_I, COLOR_ORANGE},
+  {205, 90, LETTER_S, 0xF81F}   // Magenta
+};
+
+#endif
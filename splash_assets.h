@@ -0,0 +1,161 @@
+// splash_assets.h - GENERATED by tools/gen_splash_assets.py from splash_art.h
+// Do not edit; change splash_art.h and rebuild.
+#ifndef SPLASH_ASSETS_H
+#define SPLASH_ASSETS_H
+
+#include <stdint.h>
+
+#define SPLASH_WIDTH 320
+#define SPLASH_HEIGHT 240
+#define SPLASH_RUNS 865  // 3460 bytes vs 153600 raw
+
+// (run length, RGB565) pairs, row-major; kept in flash
+static const uint16_t SPLASH_RLE[SPLASH_RUNS * 2] = {
+  4840, 0x0000, 7, 0x07FF, 1, 0x0000, 7, 0x07FF, 1, 0x0000, 7, 0x07FF,
+  1, 0x0000, 7, 0x07FF, 289, 0x0000, 7, 0x07FF, 1, 0x0000, 7, 0x07FF,
+  1, 0x0000, 7, 0x07FF, 1, 0x0000, 7, 0x07FF, 289, 0x0000, 7, 0x07FF,
+  1, 0x0000, 7, 0x07FF, 1, 0x0000, 7, 0x07FF, 1, 0x0000, 7, 0x07FF,
+  289, 0x0000, 7, 0x07FF, 1, 0x0000, 7, 0x07FF, 1, 0x0000, 7, 0x07FF,
+  1, 0x0000, 7, 0x07FF, 179, 0x0000, 7, 0xFFE0, 1, 0x0000, 7, 0xFFE0,
+  95, 0x0000, 7, 0x07FF, 1, 0x0000, 7, 0x07FF, 1, 0x0000, 7, 0x07FF,
+  1, 0x0000, 7, 0x07FF, 179, 0x0000, 7, 0xFFE0, 1, 0x0000, 7, 0xFFE0,
+  95, 0x0000, 7, 0x07FF, 1, 0x0000, 7, 0x07FF, 1, 0x0000, 7, 0x07FF,
+  1, 0x0000, 7, 0x07FF, 179, 0x0000, 7, 0xFFE0, 1, 0x0000, 7, 0xFFE0,
+  95, 0x0000, 7, 0x07FF, 1, 0x0000, 7, 0x07FF, 1, 0x0000, 7, 0x07FF,
+  1, 0x0000, 7, 0x07FF, 179, 0x0000, 7, 0xFFE0, 1, 0x0000, 7, 0xFFE0,
+  305, 0x0000, 7, 0xFFE0, 1, 0x0000, 7, 0xFFE0, 305, 0x0000, 7, 0xFFE0,
+  1, 0x0000, 7, 0xFFE0, 305, 0x0000, 7, 0xFFE0, 1, 0x0000, 7, 0xFFE0,
+  625, 0x0000, 7, 0xFFE0, 1, 0x0000, 7, 0xFFE0, 305, 0x0000, 7, 0xFFE0,
+  1, 0x0000, 7, 0xFFE0, 305, 0x0000, 7, 0xFFE0, 1, 0x0000, 7, 0xFFE0,
+  305, 0x0000, 7, 0xFFE0, 1, 0x0000, 7, 0xFFE0, 305, 0x0000, 7, 0xFFE0,
+  1, 0x0000, 7, 0xFFE0, 305, 0x0000, 7, 0xFFE0, 1, 0x0000, 7, 0xFFE0,
+  305, 0x0000, 7, 0xFFE0, 1, 0x0000, 7, 0xFFE0, 8725, 0x0000, 7, 0xF800,
+  1, 0x0000, 7, 0xF800, 305, 0x0000, 7, 0xF800, 1, 0x0000, 7, 0xF800,
+  305, 0x0000, 7, 0xF800, 1, 0x0000, 7, 0xF800, 305, 0x0000, 7, 0xF800,
+  1, 0x0000, 7, 0xF800, 305, 0x0000, 7, 0xF800, 1, 0x0000, 7, 0xF800,
+  305, 0x0000, 7, 0xF800, 1, 0x0000, 7, 0xF800, 223, 0x0000, 7, 0x07E0,
+  1, 0x0000, 7, 0x07E0, 67, 0x0000, 7, 0xF800, 1, 0x0000, 7, 0xF800,
+  223, 0x0000, 7, 0x07E0, 1, 0x0000, 7, 0x07E0, 305, 0x0000, 7, 0x07E0,
+  1, 0x0000, 7, 0x07E0, 75, 0x0000, 7, 0xF800, 1, 0x0000, 7, 0xF800,
+  215, 0x0000, 7, 0x07E0, 1, 0x0000, 7, 0x07E0, 75, 0x0000, 7, 0xF800,
+  1, 0x0000, 7, 0xF800, 215, 0x0000, 7, 0x07E0, 1, 0x0000, 7, 0x07E0,
+  75, 0x0000, 7, 0xF800, 1, 0x0000, 7, 0xF800, 215, 0x0000, 7, 0x07E0,
+  1, 0x0000, 7, 0x07E0, 75, 0x0000, 7, 0xF800, 1, 0x0000, 7, 0xF800,
+  215, 0x0000, 7, 0x07E0, 1, 0x0000, 7, 0x07E0, 75, 0x0000, 7, 0xF800,
+  1, 0x0000, 7, 0xF800, 305, 0x0000, 7, 0xF800, 1, 0x0000, 7, 0xF800,
+  207, 0x0000, 7, 0x07E0, 1, 0x0000, 7, 0x07E0, 83, 0x0000, 7, 0xF800,
+  1, 0x0000, 7, 0xF800, 207, 0x0000, 7, 0x07E0, 1, 0x0000, 7, 0x07E0,
+  305, 0x0000, 7, 0x07E0, 1, 0x0000, 7, 0x07E0, 305, 0x0000, 7, 0x07E0,
+  1, 0x0000, 7, 0x07E0, 305, 0x0000, 7, 0x07E0, 1, 0x0000, 7, 0x07E0,
+  305, 0x0000, 7, 0x07E0, 1, 0x0000, 7, 0x07E0, 305, 0x0000, 7, 0x07E0,
+  1, 0x0000, 7, 0x07E0, 3325, 0x0000, 3, 0x07FF, 1, 0x0000, 3, 0x07FF,
+  1, 0x0000, 3, 0x07FF, 1, 0x0000, 3, 0x07FF, 1, 0x0000, 3, 0x07FF,
+  6, 0x0000, 3, 0xFFE0, 1, 0x0000, 3, 0xFFE0, 1, 0x0000, 3, 0xFFE0,
+  1, 0x0000, 3, 0xFFE0, 1, 0x0000, 3, 0xFFE0, 6, 0x0000, 3, 0x07E0,
+  1, 0x0000, 3, 0x07E0, 1, 0x0000, 3, 0x07E0, 1, 0x0000, 3, 0x07E0,
+  1, 0x0000, 3, 0x07E0, 10, 0x0000, 3, 0xF800, 1, 0x0000, 3, 0xF800,
+  1, 0x0000, 3, 0xF800, 1, 0x0000, 3, 0xF800, 6, 0x0000, 3, 0xFD20,
+  1, 0x0000, 3, 0xFD20, 1, 0x0000, 3, 0xFD20, 1, 0x0000, 3, 0xFD20,
+  1, 0x0000, 3, 0xFD20, 10, 0x0000, 3, 0xF81F, 1, 0x0000, 3, 0xF81F,
+  1, 0x0000, 3, 0xF81F, 1, 0x0000, 3, 0xF81F, 176, 0x0000, 3, 0x07FF,
+  1, 0x0000, 3, 0x07FF, 1, 0x0000, 3, 0x07FF, 1, 0x0000, 3, 0x07FF,
+  1, 0x0000, 3, 0x07FF, 6, 0x0000, 3, 0xFFE0, 1, 0x0000, 3, 0xFFE0,
+  1, 0x0000, 3, 0xFFE0, 1, 0x0000, 3, 0xFFE0, 1, 0x0000, 3, 0xFFE0,
+  6, 0x0000, 3, 0x07E0, 1, 0x0000, 3, 0x07E0, 1, 0x0000, 3, 0x07E0,
+  1, 0x0000, 3, 0x07E0, 1, 0x0000, 3, 0x07E0, 10, 0x0000, 3, 0xF800,
+  1, 0x0000, 3, 0xF800, 1, 0x0000, 3, 0xF800, 1, 0x0000, 3, 0xF800,
+  6, 0x0000, 3, 0xFD20, 1, 0x0000, 3, 0xFD20, 1, 0x0000, 3, 0xFD20,
+  1, 0x0000, 3, 0xFD20, 1, 0x0000, 3, 0xFD20, 10, 0x0000, 3, 0xF81F,
+  1, 0x0000, 3, 0xF81F, 1, 0x0000, 3, 0xF81F, 1, 0x0000, 3, 0xF81F,
+  176, 0x0000, 3, 0x07FF, 1, 0x0000, 3, 0x07FF, 1, 0x0000, 3, 0x07FF,
+  1, 0x0000, 3, 0x07FF, 1, 0x0000, 3, 0x07FF, 6, 0x0000, 3, 0xFFE0,
+  1, 0x0000, 3, 0xFFE0, 1, 0x0000, 3, 0xFFE0, 1, 0x0000, 3, 0xFFE0,
+  1, 0x0000, 3, 0xFFE0, 6, 0x0000, 3, 0x07E0, 1, 0x0000, 3, 0x07E0,
+  1, 0x0000, 3, 0x07E0, 1, 0x0000, 3, 0x07E0, 1, 0x0000, 3, 0x07E0,
+  10, 0x0000, 3, 0xF800, 1, 0x0000, 3, 0xF800, 1, 0x0000, 3, 0xF800,
+  1, 0x0000, 3, 0xF800, 6, 0x0000, 3, 0xFD20, 1, 0x0000, 3, 0xFD20,
+  1, 0x0000, 3, 0xFD20, 1, 0x0000, 3, 0xFD20, 1, 0x0000, 3, 0xFD20,
+  10, 0x0000, 3, 0xF81F, 1, 0x0000, 3, 0xF81F, 1, 0x0000, 3, 0xF81F,
+  1, 0x0000, 3, 0xF81F, 504, 0x0000, 3, 0x07FF, 14, 0x0000, 3, 0xFFE0,
+  30, 0x0000, 3, 0x07E0, 14, 0x0000, 3, 0xF800, 13, 0x0000, 3, 0xF800,
+  14, 0x0000, 3, 0xFD20, 14, 0x0000, 3, 0xF81F, 200, 0x0000, 3, 0x07FF,
+  14, 0x0000, 3, 0xFFE0, 30, 0x0000, 3, 0x07E0, 14, 0x0000, 3, 0xF800,
+  13, 0x0000, 3, 0xF800, 14, 0x0000, 3, 0xFD20, 14, 0x0000, 3, 0xF81F,
+  200, 0x0000, 3, 0x07FF, 14, 0x0000, 3, 0xFFE0, 30, 0x0000, 3, 0x07E0,
+  14, 0x0000, 3, 0xF800, 13, 0x0000, 3, 0xF800, 14, 0x0000, 3, 0xFD20,
+  14, 0x0000, 3, 0xF81F, 520, 0x0000, 3, 0x07FF, 14, 0x0000, 3, 0xFFE0,
+  30, 0x0000, 3, 0x07E0, 14, 0x0000, 3, 0xF800, 13, 0x0000, 3, 0xF800,
+  14, 0x0000, 3, 0xFD20, 14, 0x0000, 3, 0xF81F, 200, 0x0000, 3, 0x07FF,
+  14, 0x0000, 3, 0xFFE0, 30, 0x0000, 3, 0x07E0, 14, 0x0000, 3, 0xF800,
+  13, 0x0000, 3, 0xF800, 14, 0x0000, 3, 0xFD20, 14, 0x0000, 3, 0xF81F,
+  200, 0x0000, 3, 0x07FF, 14, 0x0000, 3, 0xFFE0, 30, 0x0000, 3, 0x07E0,
+  14, 0x0000, 3, 0xF800, 13, 0x0000, 3, 0xF800, 14, 0x0000, 3, 0xFD20,
+  14, 0x0000, 3, 0xF81F, 520, 0x0000, 3, 0x07FF, 14, 0x0000, 3, 0xFFE0,
+  1, 0x0000, 3, 0xFFE0, 1, 0x0000, 3, 0xFFE0, 1, 0x0000, 3, 0xFFE0,
+  18, 0x0000, 3, 0x07E0, 18, 0x0000, 3, 0xF800, 1, 0x0000, 3, 0xF800,
+  1, 0x0000, 3, 0xF800, 1, 0x0000, 3, 0xF800, 14, 0x0000, 3, 0xFD20,
+  18, 0x0000, 3, 0xF81F, 1, 0x0000, 3, 0xF81F, 1, 0x0000, 3, 0xF81F,
+  188, 0x0000, 3, 0x07FF, 14, 0x0000, 3, 0xFFE0, 1, 0x0000, 3, 0xFFE0,
+  1, 0x0000, 3, 0xFFE0, 1, 0x0000, 3, 0xFFE0, 18, 0x0000, 3, 0x07E0,
+  18, 0x0000, 3, 0xF800, 1, 0x0000, 3, 0xF800, 1, 0x0000, 3, 0xF800,
+  1, 0x0000, 3, 0xF800, 14, 0x0000, 3, 0xFD20, 18, 0x0000, 3, 0xF81F,
+  1, 0x0000, 3, 0xF81F, 1, 0x0000, 3, 0xF81F, 188, 0x0000, 3, 0x07FF,
+  14, 0x0000, 3, 0xFFE0, 1, 0x0000, 3, 0xFFE0, 1, 0x0000, 3, 0xFFE0,
+  1, 0x0000, 3, 0xFFE0, 18, 0x0000, 3, 0x07E0, 18, 0x0000, 3, 0xF800,
+  1, 0x0000, 3, 0xF800, 1, 0x0000, 3, 0xF800, 1, 0x0000, 3, 0xF800,
+  14, 0x0000, 3, 0xFD20, 18, 0x0000, 3, 0xF81F, 1, 0x0000, 3, 0xF81F,
+  1, 0x0000, 3, 0xF81F, 508, 0x0000, 3, 0x07FF, 14, 0x0000, 3, 0xFFE0,
+  30, 0x0000, 3, 0x07E0, 22, 0x0000, 3, 0xF800, 5, 0x0000, 3, 0xF800,
+  14, 0x0000, 3, 0xFD20, 30, 0x0000, 3, 0xF81F, 184, 0x0000, 3, 0x07FF,
+  14, 0x0000, 3, 0xFFE0, 30, 0x0000, 3, 0x07E0, 22, 0x0000, 3, 0xF800,
+  5, 0x0000, 3, 0xF800, 14, 0x0000, 3, 0xFD20, 30, 0x0000, 3, 0xF81F,
+  184, 0x0000, 3, 0x07FF, 14, 0x0000, 3, 0xFFE0, 30, 0x0000, 3, 0x07E0,
+  22, 0x0000, 3, 0xF800, 5, 0x0000, 3, 0xF800, 14, 0x0000, 3, 0xFD20,
+  30, 0x0000, 3, 0xF81F, 504, 0x0000, 3, 0x07FF, 14, 0x0000, 3, 0xFFE0,
+  30, 0x0000, 3, 0x07E0, 18, 0x0000, 3, 0xF800, 9, 0x0000, 3, 0xF800,
+  14, 0x0000, 3, 0xFD20, 30, 0x0000, 3, 0xF81F, 184, 0x0000, 3, 0x07FF,
+  14, 0x0000, 3, 0xFFE0, 30, 0x0000, 3, 0x07E0, 18, 0x0000, 3, 0xF800,
+  9, 0x0000, 3, 0xF800, 14, 0x0000, 3, 0xFD20, 30, 0x0000, 3, 0xF81F,
+  184, 0x0000, 3, 0x07FF, 14, 0x0000, 3, 0xFFE0, 30, 0x0000, 3, 0x07E0,
+  18, 0x0000, 3, 0xF800, 9, 0x0000, 3, 0xF800, 14, 0x0000, 3, 0xFD20,
+  30, 0x0000, 3, 0xF81F, 504, 0x0000, 3, 0x07FF, 14, 0x0000, 3, 0xFFE0,
+  1, 0x0000, 3, 0xFFE0, 1, 0x0000, 3, 0xFFE0, 1, 0x0000, 3, 0xFFE0,
+  1, 0x0000, 3, 0xFFE0, 14, 0x0000, 3, 0x07E0, 14, 0x0000, 3, 0xF800,
+  13, 0x0000, 3, 0xF800, 6, 0x0000, 3, 0xFD20, 1, 0x0000, 3, 0xFD20,
+  1, 0x0000, 3, 0xFD20, 1, 0x0000, 3, 0xFD20, 1, 0x0000, 3, 0xFD20,
+  6, 0x0000, 3, 0xF81F, 1, 0x0000, 3, 0xF81F, 1, 0x0000, 3, 0xF81F,
+  1, 0x0000, 3, 0xF81F, 188, 0x0000, 3, 0x07FF, 14, 0x0000, 3, 0xFFE0,
+  1, 0x0000, 3, 0xFFE0, 1, 0x0000, 3, 0xFFE0, 1, 0x0000, 3, 0xFFE0,
+  1, 0x0000, 3, 0xFFE0, 14, 0x0000, 3, 0x07E0, 14, 0x0000, 3, 0xF800,
+  13, 0x0000, 3, 0xF800, 6, 0x0000, 3, 0xFD20, 1, 0x0000, 3, 0xFD20,
+  1, 0x0000, 3, 0xFD20, 1, 0x0000, 3, 0xFD20, 1, 0x0000, 3, 0xFD20,
+  6, 0x0000, 3, 0xF81F, 1, 0x0000, 3, 0xF81F, 1, 0x0000, 3, 0xF81F,
+  1, 0x0000, 3, 0xF81F, 188, 0x0000, 3, 0x07FF, 14, 0x0000, 3, 0xFFE0,
+  1, 0x0000, 3, 0xFFE0, 1, 0x0000, 3, 0xFFE0, 1, 0x0000, 3, 0xFFE0,
+  1, 0x0000, 3, 0xFFE0, 14, 0x0000, 3, 0x07E0, 14, 0x0000, 3, 0xF800,
+  13, 0x0000, 3, 0xF800, 6, 0x0000, 3, 0xFD20, 1, 0x0000, 3, 0xFD20,
+  1, 0x0000, 3, 0xFD20, 1, 0x0000, 3, 0xFD20, 1, 0x0000, 3, 0xFD20,
+  6, 0x0000, 3, 0xF81F, 1, 0x0000, 3, 0xF81F, 1, 0x0000, 3, 0xF81F,
+  1, 0x0000, 3, 0xF81F, 20305, 0x0000, 7, 0xFD20, 1, 0x0000, 7, 0xFD20,
+  1, 0x0000, 7, 0xFD20, 297, 0x0000, 7, 0xFD20, 1, 0x0000, 7, 0xFD20,
+  1, 0x0000, 7, 0xFD20, 297, 0x0000, 7, 0xFD20, 1, 0x0000, 7, 0xFD20,
+  1, 0x0000, 7, 0xFD20, 297, 0x0000, 7, 0xFD20, 1, 0x0000, 7, 0xFD20,
+  1, 0x0000, 7, 0xFD20, 297, 0x0000, 7, 0xFD20, 1, 0x0000, 7, 0xFD20,
+  1, 0x0000, 7, 0xFD20, 297, 0x0000, 7, 0xFD20, 1, 0x0000, 7, 0xFD20,
+  1, 0x0000, 7, 0xFD20, 172, 0x0000, 7, 0x001F, 1, 0x0000, 7, 0x001F,
+  1, 0x0000, 7, 0x001F, 102, 0x0000, 7, 0xFD20, 1, 0x0000, 7, 0xFD20,
+  1, 0x0000, 7, 0xFD20, 172, 0x0000, 7, 0x001F, 1, 0x0000, 7, 0x001F,
+  1, 0x0000, 7, 0x001F, 297, 0x0000, 7, 0x001F, 1, 0x0000, 7, 0x001F,
+  1, 0x0000, 7, 0x001F, 118, 0x0000, 7, 0xFD20, 172, 0x0000, 7, 0x001F,
+  1, 0x0000, 7, 0x001F, 1, 0x0000, 7, 0x001F, 118, 0x0000, 7, 0xFD20,
+  172, 0x0000, 7, 0x001F, 1, 0x0000, 7, 0x001F, 1, 0x0000, 7, 0x001F,
+  118, 0x0000, 7, 0xFD20, 172, 0x0000, 7, 0x001F, 1, 0x0000, 7, 0x001F,
+  1, 0x0000, 7, 0x001F, 118, 0x0000, 7, 0xFD20, 172, 0x0000, 7, 0x001F,
+  1, 0x0000, 7, 0x001F, 1, 0x0000, 7, 0x001F, 118, 0x0000, 7, 0xFD20,
+  313, 0x0000, 7, 0xFD20, 172, 0x0000, 7, 0x001F, 134, 0x0000, 7, 0xFD20,
+  172, 0x0000, 7, 0x001F, 313, 0x0000, 7, 0x001F, 313, 0x0000, 7, 0x001F,
+  313, 0x0000, 7, 0x001F, 313, 0x0000, 7, 0x001F, 313, 0x0000, 7, 0x001F,
+  12873, 0x0000
+};
+
+#endif
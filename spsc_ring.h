@@ -0,0 +1,44 @@
+// spsc_ring.h - Lock-free single-producer/single-consumer ring buffer
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stdint.h>
+#include <atomic>
+
+// One task pushes, another pops; neither ever waits on the other.
+// N must be a power of two.
+template <typename T, int N>
+class SpscRing {
+public:
+  SpscRing() : head(0), tail(0) {}
+  
+  // Returns false (and drops the item) when full
+  bool push(const T& item) {
+    uint32_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) >= N) return false;
+    items[h & (N - 1)] = item;
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+  
+  bool pop(T& item) {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    if (t == head.load(std::memory_order_acquire)) return false;
+    item = items[t & (N - 1)];
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+  
+  int count() {
+    return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+  }
+  
+private:
+  static_assert((N & (N - 1)) == 0, "SpscRing size must be a power of two");
+  
+  T items[N];
+  std::atomic<uint32_t> head;
+  std::atomic<uint32_t> tail;
+};
+
+#endif
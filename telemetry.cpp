@@ -0,0 +1,218 @@
+// telemetry.cpp - Binary game state stream over Serial for M5Core2 Tetris
+//
+// Frame layout before COBS: type, uint16 tick, payload, CRC-8. All values
+// are little endian. Deltas are taken against what the host was last sent,
+// so a frame dropped for lack of UART space is simply folded into the next.
+// At most TLM_MAX_ROWS rows go out per frame; anything left over stays
+// dirty. One extra row is refreshed per tick so a late reader converges
+// within FIELD_HEIGHT ticks.
+#include "telemetry.h"
+
+#define TLM_MAX_FRAME 96
+
+static uint8_t sentRows[FIELD_HEIGHT][FIELD_WIDTH / 2];
+static uint8_t sentPiece[3];
+static int32_t sentScore;
+static uint16_t sentLines;
+static uint8_t sentLevel;
+static int8_t sentHeld;
+static uint8_t sentNext;
+static uint16_t tick = 0;
+static int refreshRow = 0;
+static int ticksSinceKey = TLM_KEYFRAME_TICKS;
+
+static uint8_t crc8(const uint8_t* data, int length) {
+  uint8_t crc = 0;
+  for (int i = 0; i < length; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+    }
+  }
+  return crc;
+}
+
+// Adds the CRC, COBS encodes and writes the frame. Drops it rather than
+// wait if the UART can't take it all right now.
+static bool sendFrame(uint8_t* frame, int length) {
+  uint8_t encoded[TLM_MAX_FRAME + 4];
+  int out = 1, code = 1, codePos = 0;
+  
+  frame[length] = crc8(frame, length);
+  length++;
+  
+  for (int i = 0; i < length; i++) {
+    if (frame[i] == 0) {
+      encoded[codePos] = code;
+      codePos = out++;
+      code = 1;
+    } else {
+      encoded[out++] = frame[i];
+      if (++code == 0xFF) {
+        encoded[codePos] = code;
+        codePos = out++;
+        code = 1;
+      }
+    }
+  }
+  encoded[codePos] = code;
+  encoded[out++] = 0;
+  
+  if (Serial.availableForWrite() < out) return false;
+  Serial.write(encoded, out);
+  return true;
+}
+
+static void packRow(TetrisGame& game, int y, uint8_t* out) {
+  for (int i = 0; i < FIELD_WIDTH / 2; i++) {
+    out[i] = game.getCell(2 * i, y) | (game.getCell(2 * i + 1, y) << 4);
+  }
+}
+
+static void putU16(uint8_t* buf, int& pos, uint16_t value) {
+  buf[pos++] = value & 0xFF;
+  buf[pos++] = value >> 8;
+}
+
+static void putU32(uint8_t* buf, int& pos, uint32_t value) {
+  putU16(buf, pos, value & 0xFFFF);
+  putU16(buf, pos, value >> 16);
+}
+
+void initTelemetry() {
+  // Serial is already running at 115200 from setup()
+  telemetryStartGame();
+}
+
+void telemetryStartGame() {
+  uint8_t frame[TLM_MAX_FRAME];
+  int pos = 0;
+  
+  // Forget everything so the first ticks carry a full picture
+  memset(sentRows, 0xFF, sizeof(sentRows));
+  sentScore = -1;
+  sentHeld = -2;
+  ticksSinceKey = TLM_KEYFRAME_TICKS;
+  
+  frame[pos++] = TLM_TYPE_START;
+  putU16(frame, pos, tick++);
+  sendFrame(frame, pos);
+}
+
+void telemetryTick(TetrisGame& game, uint16_t frameUs) {
+  uint8_t frame[TLM_MAX_FRAME];
+  uint8_t packed[FIELD_HEIGHT][FIELD_WIDTH / 2];
+  uint32_t rowMask = 0;
+  int rowCount = 0;
+  uint8_t flags = 0;
+  int pos = 0;
+  
+  // Changed rows first, bottom up since that's where play happens
+  for (int y = FIELD_HEIGHT - 1; y >= 0 && rowCount < TLM_MAX_ROWS; y--) {
+    packRow(game, y, packed[y]);
+    if (memcmp(packed[y], sentRows[y], sizeof(packed[y])) != 0) {
+      rowMask |= 1UL << y;
+      rowCount++;
+    }
+  }
+  if (rowCount < TLM_MAX_ROWS && !(rowMask & (1UL << refreshRow))) {
+    packRow(game, refreshRow, packed[refreshRow]);
+    rowMask |= 1UL << refreshRow;
+  }
+  if (rowMask) flags |= TLM_ROWS;
+  
+  bool keyframe = ++ticksSinceKey >= TLM_KEYFRAME_TICKS;
+  uint8_t piece[3] = {
+    (uint8_t)(game.getCurrentPiece() | (game.getRotation() << 4)),
+    (uint8_t)game.getPosX(),
+    (uint8_t)game.getPosY()
+  };
+  if (keyframe || memcmp(piece, sentPiece, sizeof(piece)) != 0) flags |= TLM_PIECE;
+  if (keyframe || game.getScore() != sentScore) flags |= TLM_SCORE;
+  if (keyframe || game.getLinesCleared() != sentLines || game.getLevel() != sentLevel) flags |= TLM_LINES;
+  if (keyframe || game.getHeldPiece() != sentHeld || game.getNextPiece() != sentNext) flags |= TLM_QUEUE;
+  
+  frame[pos++] = TLM_TYPE_TICK;
+  putU16(frame, pos, tick++);
+  frame[pos++] = flags;
+  putU16(frame, pos, frameUs);
+  
+  if (flags & TLM_ROWS) {
+    frame[pos++] = rowMask & 0xFF;
+    frame[pos++] = (rowMask >> 8) & 0xFF;
+    frame[pos++] = (rowMask >> 16) & 0xFF;
+    for (int y = 0; y < FIELD_HEIGHT; y++) {
+      if (!(rowMask & (1UL << y))) continue;
+      memcpy(&frame[pos], packed[y], FIELD_WIDTH / 2);
+      pos += FIELD_WIDTH / 2;
+    }
+  }
+  if (flags & TLM_PIECE) {
+    memcpy(&frame[pos], piece, sizeof(piece));
+    pos += sizeof(piece);
+  }
+  if (flags & TLM_SCORE) {
+    putU32(frame, pos, game.getScore());
+  }
+  if (flags & TLM_LINES) {
+    putU16(frame, pos, game.getLinesCleared());
+    frame[pos++] = game.getLevel();
+  }
+  if (flags & TLM_QUEUE) {
+    frame[pos++] = (uint8_t)game.getHeldPiece();
+    frame[pos++] = game.getNextPiece();
+  }
+  
+  if (!sendFrame(frame, pos)) return;  // Resent as a delta next tick
+  
+  for (int y = 0; y < FIELD_HEIGHT; y++) {
+    if (rowMask & (1UL << y)) memcpy(sentRows[y], packed[y], FIELD_WIDTH / 2);
+  }
+  memcpy(sentPiece, piece, sizeof(piece));
+  sentScore = game.getScore();
+  sentLines = game.getLinesCleared();
+  sentLevel = game.getLevel();
+  sentHeld = game.getHeldPiece();
+  sentNext = game.getNextPiece();
+  refreshRow = (refreshRow + 1) % FIELD_HEIGHT;
+  if (keyframe) ticksSinceKey = 0;
+}
+
+void telemetryGameOver(TetrisGame& game) {
+  uint8_t frame[TLM_MAX_FRAME];
+  int pos = 0;
+  
+  frame[pos++] = TLM_TYPE_GAME_OVER;
+  putU16(frame, pos, tick++);
+  putU32(frame, pos, game.getScore());
+  putU16(frame, pos, game.getLinesCleared());
+  frame[pos++] = game.getLevel();
+  sendFrame(frame, pos);
+}
+
+// game, uptime, heap, min heap, largest block, frag %, then per task:
+// uint16 stack free, name length, name
+void telemetryMemory(const MemorySample& sample) {
+  uint8_t frame[TLM_MAX_FRAME];
+  int pos = 0;
+  
+  frame[pos++] = TLM_TYPE_MEMORY;
+  putU16(frame, pos, tick++);
+  putU32(frame, pos, sample.game);
+  putU32(frame, pos, sample.uptime);
+  putU32(frame, pos, sample.freeHeap);
+  putU32(frame, pos, sample.minFreeHeap);
+  putU32(frame, pos, sample.largestBlock);
+  frame[pos++] = sample.fragmentation;
+  putU32(frame, pos, sample.allocatedBlocks);
+  putU32(frame, pos, sample.failedAllocs);
+  putU32(frame, pos, (uint32_t)sample.heapDrift);  // Signed on the wire
+  for (int i = 0; i < sample.taskCount; i++) {
+    int length = min((int)strlen(sample.taskName[i]), 8);
+    putU16(frame, pos, sample.stackFree[i]);
+    frame[pos++] = length;
+    memcpy(&frame[pos], sample.taskName[i], length);
+    pos += length;
+  }
+  sendFrame(frame, pos);
+}
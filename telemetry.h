@@ -0,0 +1,32 @@
+// telemetry.h - Binary game state stream over Serial for M5Core2 Tetris
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "tetris.h"
+#include "memmon.h"
+
+// Every frame is COBS encoded and ends in a 0x00 byte, so a reader can
+// join mid-stream and resync at the next zero. Decode captures with
+// tools/telemetry_decode.py.
+#define TLM_TYPE_TICK 1
+#define TLM_TYPE_START 2
+#define TLM_TYPE_GAME_OVER 3
+#define TLM_TYPE_MEMORY 4
+
+// Sections present in a tick frame, in this order after the frame time
+#define TLM_ROWS  0x01  // 3 byte row mask, then 6 bytes (12 nibbles) per row
+#define TLM_PIECE 0x02  // piece | rot << 4, x, y
+#define TLM_SCORE 0x04  // uint32 score
+#define TLM_LINES 0x08  // uint16 lines, uint8 level
+#define TLM_QUEUE 0x10  // int8 held piece, uint8 next piece
+
+#define TLM_MAX_ROWS 8          // Keeps a frame under the 128 byte UART FIFO
+#define TLM_KEYFRAME_TICKS 30   // Resend piece/score/queue at least this often
+
+void initTelemetry();
+void telemetryStartGame();
+void telemetryTick(TetrisGame& game, uint16_t frameUs);
+void telemetryGameOver(TetrisGame& game);
+void telemetryMemory(const MemorySample& sample);
+
+#endif
@@ -0,0 +1,69 @@
+// alloc_count.cpp - Count every heap allocation in a host target
+//
+// Linking this replaces malloc and friends for the whole process (the C++
+// runtime's operator new included) with counting wrappers around glibc's.
+// The ESP and heap_caps stand-ins report these counts, so memmon sees the
+// host's real allocations.
+#include "Arduino.h"
+
+#include <atomic>
+#include <malloc.h>
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void __libc_free(void* ptr);
+}
+
+static std::atomic<unsigned long> allocs(0);
+static std::atomic<unsigned long> liveBlocks(0);
+static std::atomic<unsigned long> liveBytes(0);
+static std::atomic<unsigned long> peakBytes(0);
+
+static void countAlloc(void* ptr) {
+  if (!ptr) return;
+  allocs++;
+  liveBlocks++;
+  unsigned long live = liveBytes += malloc_usable_size(ptr);
+  unsigned long peak = peakBytes;
+  while (live > peak && !peakBytes.compare_exchange_weak(peak, live)) {}
+}
+
+static void countFree(void* ptr) {
+  if (!ptr) return;
+  liveBlocks--;
+  liveBytes -= malloc_usable_size(ptr);
+}
+
+extern "C" {
+
+void* malloc(size_t size) {
+  void* ptr = __libc_malloc(size);
+  countAlloc(ptr);
+  return ptr;
+}
+
+void* calloc(size_t count, size_t size) {
+  void* ptr = __libc_calloc(count, size);
+  countAlloc(ptr);
+  return ptr;
+}
+
+void* realloc(void* ptr, size_t size) {
+  countFree(ptr);
+  void* result = __libc_realloc(ptr, size);
+  countAlloc(result ? result : (size ? ptr : nullptr));
+  return result;
+}
+
+void free(void* ptr) {
+  countFree(ptr);
+  __libc_free(ptr);
+}
+
+}
+
+HostAllocStats hostAllocStats() {
+  return HostAllocStats{allocs, liveBlocks, liveBytes, peakBytes};
+}
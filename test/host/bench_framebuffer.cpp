@@ -0,0 +1,81 @@
+// bench_framebuffer.cpp - 4bpp expansion throughput on the host
+//
+// Times IndexedCanvas::expandLines() on a field-sized canvas against a
+// plain per-pixel palette lookup, and checks both give the same pixels.
+// Absolute numbers are the PC's; the ratio is what carries over.
+#include "framebuffer.h"
+
+#define WIDTH 144
+#define HEIGHT 216
+#define RUNS 2000
+
+static uint8_t pixels[WIDTH * HEIGHT / 2];
+static uint16_t palette[PAL_SIZE];
+static uint16_t lutOut[SCANLINE_PIXELS];
+static uint16_t naiveOut[SCANLINE_PIXELS];
+
+// What expansion would cost without the pair table: unpack each nibble
+// and byte-swap its color
+static void naiveExpand(int y, int count, uint16_t* out) {
+  for (int line = 0; line < count; line++) {
+    const uint8_t* src = &pixels[(y + line) * (WIDTH / 2)];
+    for (int x = 0; x < WIDTH; x++) {
+      uint8_t index = (x & 1) ? src[x >> 1] >> 4 : src[x >> 1] & 0x0F;
+      uint16_t color = palette[index];
+      *out++ = (color >> 8) | (color << 8);
+    }
+  }
+}
+
+int main() {
+  IndexedCanvas canvas(pixels, WIDTH, HEIGHT);
+  int band = SCANLINE_PIXELS / WIDTH;
+  uint32_t checksum = 0;
+  
+  for (int i = 0; i < PAL_SIZE; i++) {
+    palette[i] = i * 0x1111;
+    setPaletteColor(i, palette[i]);
+  }
+  for (int i = 0; i < (int)sizeof(pixels); i++) {
+    pixels[i] = (i * 37) ^ (i >> 3);
+  }
+  
+  for (int y = 0; y < HEIGHT; y += band) {
+    int lines = min(band, HEIGHT - y);
+    canvas.expandLines(y, lines, lutOut);
+    naiveExpand(y, lines, naiveOut);
+    if (memcmp(lutOut, naiveOut, lines * WIDTH * 2) != 0) {
+      printf("bench_framebuffer: expandLines output differs at line %d\n", y);
+      return 1;
+    }
+  }
+  
+  unsigned long start = micros();
+  for (int r = 0; r < RUNS; r++) {
+    for (int y = 0; y < HEIGHT; y += band) {
+      canvas.expandLines(y, min(band, HEIGHT - y), lutOut);
+      checksum += lutOut[r % SCANLINE_PIXELS];
+    }
+  }
+  unsigned long lutTime = micros() - start;
+  
+  start = micros();
+  for (int r = 0; r < RUNS; r++) {
+    for (int y = 0; y < HEIGHT; y += band) {
+      naiveExpand(y, min(band, HEIGHT - y), naiveOut);
+      checksum += naiveOut[r % SCANLINE_PIXELS];
+    }
+  }
+  unsigned long naiveTime = micros() - start;
+  
+  double pixelCount = (double)RUNS * WIDTH * HEIGHT;
+  printf("expandLines: %.0f Mpx/s (%.2f us per field)\n",
+         pixelCount / max(lutTime, 1UL), (double)lutTime / RUNS);
+  printf("per-pixel:   %.0f Mpx/s (%.2f us per field)\n",
+         pixelCount / max(naiveTime, 1UL), (double)naiveTime / RUNS);
+  printf("speedup %.1fx (checksum %08x)\n", (double)naiveTime / max(lutTime, 1UL), checksum);
+  
+  canvas.clear(PAL_BLACK);
+  framebufferBenchmark(canvas);
+  return 0;
+}
@@ -0,0 +1,31 @@
+// check.h - Minimal assertions for the host tests
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <stdio.h>
+
+static int checkFailures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+      printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+      checkFailures++; \
+    } \
+  } while (0)
+
+#define CHECK_EQ(actual, expected) do { \
+    long long a_ = (long long)(actual), e_ = (long long)(expected); \
+    if (a_ != e_) { \
+      printf("%s:%d: CHECK_EQ failed: %s = %lld, expected %lld\n", \
+             __FILE__, __LINE__, #actual, a_, e_); \
+      checkFailures++; \
+    } \
+  } while (0)
+
+// Call at the end of main()
+static int checkResult(const char* name) {
+  printf("%s: %s\n", name, checkFailures ? "FAILED" : "ok");
+  return checkFailures ? 1 : 0;
+}
+
+#endif
@@ -0,0 +1,79 @@
+// render_audio.cpp - Render every sound effect to WAV files on the host
+//
+// Runs the real synthesizer and mixBlock(), so what you hear is what the
+// speaker gets. Output goes to build/audio/: one file per effect plus a
+// busy stretch of play with overlapping effects and voice stealing.
+#include "audio.h"
+
+#include <sys/stat.h>
+
+static const char* EFFECT_NAMES[SFX_COUNT] = {
+  "rotate", "hold", "hard_drop", "line_clear", "tetris", "game_over"
+};
+
+static void putLe(FILE* f, uint32_t value, int bytes) {
+  for (int i = 0; i < bytes; i++) fputc((value >> (8 * i)) & 0xFF, f);
+}
+
+// 16-bit mono PCM; the header is patched once the length is known
+static void writeWav(const char* path, const int16_t* samples, int count) {
+  FILE* f = fopen(path, "wb");
+  if (!f) {
+    printf("render_audio: can't write %s\n", path);
+    exit(1);
+  }
+  fwrite("RIFF", 1, 4, f);
+  putLe(f, 36 + count * 2, 4);
+  fwrite("WAVEfmt ", 1, 8, f);
+  putLe(f, 16, 4);
+  putLe(f, 1, 2);                      // PCM
+  putLe(f, 1, 2);                      // Mono
+  putLe(f, AUDIO_SAMPLE_RATE, 4);
+  putLe(f, AUDIO_SAMPLE_RATE * 2, 4);  // Byte rate
+  putLe(f, 2, 2);                      // Block align
+  putLe(f, 16, 2);
+  fwrite("data", 1, 4, f);
+  putLe(f, count * 2, 4);
+  for (int i = 0; i < count; i++) putLe(f, (uint16_t)samples[i], 2);
+  fclose(f);
+  printf("%s: %d samples (%d ms)\n", path, count, count * 1000 / AUDIO_SAMPLE_RATE);
+}
+
+// Mix until silent; returns samples rendered
+static int renderUntilSilent(int16_t* out, int maxSamples) {
+  int count = 0;
+  while (count + AUDIO_BLOCK <= maxSamples && mixBlock(out + count)) {
+    count += AUDIO_BLOCK;
+  }
+  return count;
+}
+
+int main() {
+  static int16_t samples[AUDIO_SAMPLE_RATE * 4];
+  char path[64];
+  
+  mkdir("build", 0755);
+  mkdir("build/audio", 0755);
+  initAudioMixer();
+  
+  for (int e = 0; e < SFX_COUNT; e++) {
+    playSound((SoundEffect)e);
+    int count = renderUntilSilent(samples, sizeof(samples) / sizeof(samples[0]));
+    snprintf(path, sizeof(path), "build/audio/%s.wav", EFFECT_NAMES[e]);
+    writeWav(path, samples, count);
+  }
+  
+  // Rotate spam over a hard drop and a tetris: five effects on four voices
+  static const SoundEffect busy[] = {SFX_ROTATE, SFX_ROTATE, SFX_HARD_DROP, SFX_TETRIS, SFX_ROTATE};
+  int count = 0;
+  for (unsigned i = 0; i < sizeof(busy) / sizeof(busy[0]); i++) {
+    playSound(busy[i]);
+    for (int b = 0; b < 2; b++) {
+      if (!mixBlock(samples + count)) memset(samples + count, 0, AUDIO_BLOCK * 2);
+      count += AUDIO_BLOCK;
+    }
+  }
+  count += renderUntilSilent(samples + count, sizeof(samples) / sizeof(samples[0]) - count);
+  writeWav("build/audio/busy.wav", samples, count);
+  return 0;
+}
@@ -0,0 +1,88 @@
+// Arduino.h - Host stand-in for the Arduino/ESP32 core (test/host only)
+// Just enough of the API for the game sources to build and run on a PC.
+// FreeRTOS tasks are real threads so the persist and audio tasks run
+// concurrently with the loop like they do on the device.
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <algorithm>
+
+using std::min;
+using std::max;
+
+// Time (micros() counts from program start, like on the device)
+unsigned long micros();
+unsigned long millis();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned long us);
+
+// Tests can stop the clock and step it by hand; delay() then steps it too.
+// Only meant for single threaded tests with no tasks running.
+extern bool hostClockManual;
+void hostClockAdvance(unsigned long us);
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+// Serial output goes to stdout unless quiet; write() goes to 'out' if set
+struct HostSerial {
+  FILE* out = nullptr;
+  bool quiet = false;
+  void begin(unsigned long) {}
+  size_t printf(const char* fmt, ...);
+  size_t print(const char* s) { return printf("%s", s); }
+  size_t print(int v) { return printf("%d", v); }
+  size_t println(const char* s = "") { return printf("%s\n", s); }
+  size_t println(int v) { return printf("%d\n", v); }
+  size_t write(const uint8_t* buf, size_t n);
+  size_t write(uint8_t b) { return write(&b, 1); }
+  int availableForWrite() { return 4096; }
+};
+extern HostSerial Serial;
+
+// FreeRTOS
+typedef struct HostTask* TaskHandle_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define portMAX_DELAY 0xFFFFFFFFu
+#define tskIDLE_PRIORITY 0
+
+BaseType_t xTaskCreatePinnedToCore(void (*fn)(void*), const char* name, uint32_t stack,
+                                   void* arg, UBaseType_t priority, TaskHandle_t* handle,
+                                   BaseType_t core);
+TaskHandle_t xTaskGetCurrentTaskHandle();
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks);
+void xTaskNotifyGive(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+
+// Heap figures come from the malloc counters in alloc_count.cpp when a
+// target links it, otherwise they stay at a fixed made-up heap
+struct HostEsp {
+  uint32_t getFreeHeap();
+  uint32_t getMinFreeHeap();
+  uint32_t getMaxAllocHeap();
+};
+extern HostEsp ESP;
+
+struct HostAllocStats {
+  unsigned long allocs;      // malloc/calloc/realloc calls
+  unsigned long liveBlocks;  // currently allocated blocks
+  unsigned long liveBytes;
+  unsigned long peakBytes;
+};
+HostAllocStats hostAllocStats();
+
+#endif
@@ -0,0 +1,109 @@
+// M5Core2.h - Host stand-in for the M5Core2 library (test/host only)
+// Drawing calls are no-ops, except that pushed pixels can be captured into
+// a screen sized buffer; buttons and touch never fire.
+#ifndef HOST_M5CORE2_H
+#define HOST_M5CORE2_H
+
+#include "Arduino.h"
+
+#define TFT_BLACK 0x0000
+#define TFT_WHITE 0xFFFF
+
+#define HOST_LCD_WIDTH 320
+#define HOST_LCD_HEIGHT 240
+
+struct TouchPoint_t {
+  int16_t x;
+  int16_t y;
+};
+
+struct HotZone_t {
+  HotZone_t(int16_t x0, int16_t y0, int16_t x1, int16_t y1) : x0(x0), y0(y0), x1(x1), y1(y1) {}
+  bool inHotZone(TouchPoint_t p) { return p.x >= x0 && p.x <= x1 && p.y >= y0 && p.y <= y1; }
+  int16_t x0, y0, x1, y1;
+};
+
+struct HostLcd {
+  unsigned long pixelsPushed = 0;
+  uint16_t* capture = nullptr;  // HOST_LCD_WIDTH x HOST_LCD_HEIGHT, or null
+  int windowX = 0, windowY = 0, windowW = 1, cursor = 0;
+  
+  void capturePixel(uint16_t color) {
+    int x = windowX + cursor % windowW;
+    int y = windowY + cursor / windowW;
+    cursor++;
+    if (capture && x >= 0 && x < HOST_LCD_WIDTH && y >= 0 && y < HOST_LCD_HEIGHT) {
+      capture[y * HOST_LCD_WIDTH + x] = color;
+    }
+  }
+  void setRotation(int) {}
+  void fillScreen(uint16_t) {}
+  void setTextColor(uint16_t) {}
+  void setTextColor(uint16_t, uint16_t) {}
+  void setTextSize(int) {}
+  void setCursor(int, int) {}
+  template<typename T> void print(T) {}
+  template<typename T> void println(T) {}
+  void printf(const char*, ...) {}
+  void fillRect(int, int, int, int, uint16_t) {}
+  void drawRect(int, int, int, int, uint16_t) {}
+  void fillRoundRect(int, int, int, int, int, uint16_t) {}
+  void drawRoundRect(int, int, int, int, int, uint16_t) {}
+  void fillCircle(int, int, int, uint16_t) {}
+  void drawCircle(int, int, int, uint16_t) {}
+  void drawLine(int, int, int, int, uint16_t) {}
+  void drawFastHLine(int, int, int, uint16_t) {}
+  void drawFastVLine(int, int, int, uint16_t) {}
+  void drawPixel(int, int, uint16_t) {}
+  void drawString(const char*, int, int) {}
+  void drawCentreString(const char*, int, int, int) {}
+  void startWrite() {}
+  void endWrite() {}
+  void setAddrWindow(int x, int y, int w, int) {
+    windowX = x;
+    windowY = y;
+    windowW = w > 0 ? w : 1;
+    cursor = 0;
+  }
+  void pushColors(const uint16_t* data, uint32_t len, bool = true) {
+    pixelsPushed += len;
+    if (capture) {
+      for (uint32_t i = 0; i < len; i++) capturePixel(data[i]);
+    }
+  }
+  void pushColor(uint16_t color, uint32_t len) {
+    pixelsPushed += len;
+    if (capture) {
+      for (uint32_t i = 0; i < len; i++) capturePixel(color);
+    }
+  }
+};
+
+struct HostButton {
+  bool isPressed() { return false; }
+  bool wasPressed() { return false; }
+  bool wasReleased() { return false; }
+  bool pressedFor(uint32_t) { return false; }
+};
+
+struct HostTouch {
+  bool ispressed() { return false; }
+  TouchPoint_t getPressPoint() { return {-1, -1}; }
+};
+
+struct HostAxp {
+  void SetSpkEnable(bool) {}
+  void SetLcdVoltage(uint16_t) {}
+};
+
+struct HostM5 {
+  void begin(bool = true, bool = true, bool = true, bool = true) {}
+  void update() {}
+  HostLcd Lcd;
+  HostButton BtnA, BtnB, BtnC;
+  HostTouch Touch;
+  HostAxp Axp;
+};
+extern HostM5 M5;
+
+#endif
@@ -0,0 +1,41 @@
+// SPIFFS.h - Host stand-in for the ESP32 SPIFFS filesystem (test/host only)
+// Files live under spiffsRoot on the PC. spiffsWriteDelayUs stalls every
+// write to mimic flash program/erase time.
+#ifndef HOST_SPIFFS_H
+#define HOST_SPIFFS_H
+
+#include "Arduino.h"
+#include <atomic>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+extern const char* spiffsRoot;
+extern unsigned long spiffsWriteDelayUs;
+extern std::atomic<unsigned long> spiffsBytesWritten;  // Written from the flush task
+
+class File {
+public:
+  File(FILE* f = nullptr) : f(f) {}
+  operator bool() const { return f != nullptr; }
+  size_t read(uint8_t* buf, size_t size) { return fread(buf, 1, size, f); }
+  size_t write(const uint8_t* buf, size_t size);
+  size_t size();
+  int available();
+  void close();
+private:
+  FILE* f;
+};
+
+class HostSpiffs {
+public:
+  bool begin(bool formatOnFail = false);
+  File open(const char* path, const char* mode = FILE_READ);
+  bool exists(const char* path);
+  bool remove(const char* path);
+  bool rename(const char* from, const char* to);
+};
+extern HostSpiffs SPIFFS;
+
+#endif
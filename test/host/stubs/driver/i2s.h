@@ -0,0 +1,54 @@
+// driver/i2s.h - Host stand-in for the ESP-IDF I2S driver (test/host only)
+// i2s_write() blocks for the real playback time of the block, like the DMA
+// queue does, and optionally copies the samples to i2sCapture.
+#ifndef HOST_I2S_H
+#define HOST_I2S_H
+
+#include "../Arduino.h"
+
+typedef int esp_err_t;
+typedef int i2s_port_t;
+#define ESP_OK 0
+#define I2S_NUM_0 0
+#define I2S_MODE_MASTER 0x01
+#define I2S_MODE_TX 0x04
+#define I2S_BITS_PER_SAMPLE_16BIT 16
+#define I2S_CHANNEL_FMT_ONLY_RIGHT 3
+#define I2S_COMM_FORMAT_I2S 0x01
+#define I2S_COMM_FORMAT_STAND_I2S 0x01
+#define ESP_INTR_FLAG_LEVEL1 (1 << 1)
+#define I2S_PIN_NO_CHANGE (-1)
+
+typedef int i2s_mode_t;
+typedef int i2s_bits_per_sample_t;
+typedef int i2s_channel_fmt_t;
+typedef int i2s_comm_format_t;
+
+struct i2s_config_t {
+  i2s_mode_t mode;
+  int sample_rate;
+  i2s_bits_per_sample_t bits_per_sample;
+  i2s_channel_fmt_t channel_format;
+  i2s_comm_format_t communication_format;
+  int intr_alloc_flags;
+  int dma_buf_count;
+  int dma_buf_len;
+  bool use_apll;
+  bool tx_desc_auto_clear;
+};
+
+struct i2s_pin_config_t {
+  int bck_io_num;
+  int ws_io_num;
+  int data_out_num;
+  int data_in_num;
+};
+
+extern FILE* i2sCapture;
+
+esp_err_t i2s_driver_install(i2s_port_t port, const i2s_config_t* config, int queueSize, void* queue);
+esp_err_t i2s_set_pin(i2s_port_t port, const i2s_pin_config_t* pins);
+esp_err_t i2s_zero_dma_buffer(i2s_port_t port);
+esp_err_t i2s_write(i2s_port_t port, const void* src, size_t size, size_t* written, TickType_t ticks);
+
+#endif
@@ -0,0 +1,26 @@
+// esp_heap_caps.h - Host stand-in for the ESP-IDF heap API (test/host only)
+// Figures come from the malloc counters in alloc_count.cpp when linked.
+#ifndef HOST_ESP_HEAP_CAPS_H
+#define HOST_ESP_HEAP_CAPS_H
+
+#include "Arduino.h"
+
+#define MALLOC_CAP_8BIT (1 << 2)
+
+typedef int esp_err_t;
+typedef void (*esp_alloc_failed_hook_t)(size_t size, uint32_t caps, const char* function_name);
+
+struct multi_heap_info_t {
+  size_t total_free_bytes;
+  size_t total_allocated_bytes;
+  size_t largest_free_block;
+  size_t minimum_free_bytes;
+  size_t allocated_blocks;
+  size_t free_blocks;
+  size_t total_blocks;
+};
+
+void heap_caps_get_info(multi_heap_info_t* info, uint32_t caps);
+esp_err_t heap_caps_register_failed_alloc_callback(esp_alloc_failed_hook_t callback);
+
+#endif
@@ -0,0 +1,263 @@
+// stubs.cpp - Host implementations behind the stand-in headers (test/host only)
+#include "M5Core2.h"
+#include "SPIFFS.h"
+#include "driver/i2s.h"
+#include "esp_heap_caps.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <sys/stat.h>
+
+HostSerial Serial;
+HostM5 M5;
+HostEsp ESP;
+HostSpiffs SPIFFS;
+
+const char* spiffsRoot = "spiffs";
+unsigned long spiffsWriteDelayUs = 0;
+std::atomic<unsigned long> spiffsBytesWritten(0);
+FILE* i2sCapture = nullptr;
+
+// ---- Time ----
+
+static const std::chrono::steady_clock::time_point bootTime = std::chrono::steady_clock::now();
+
+bool hostClockManual = false;
+static unsigned long manualClockUs = 0;
+
+unsigned long micros() {
+  if (hostClockManual) return manualClockUs;
+  return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - bootTime).count();
+}
+
+void hostClockAdvance(unsigned long us) {
+  manualClockUs += us;
+}
+
+unsigned long millis() {
+  return micros() / 1000;
+}
+
+void delay(unsigned long ms) {
+  if (hostClockManual) {
+    hostClockAdvance(ms * 1000);
+    return;
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(unsigned long us) {
+  if (hostClockManual) {
+    hostClockAdvance(us);
+    return;
+  }
+  std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+static uint32_t randomState = 1;
+
+long random(long howbig) {
+  if (howbig <= 0) return 0;
+  randomState = randomState * 1103515245 + 12345;
+  return (randomState >> 8) % howbig;
+}
+
+long random(long howsmall, long howbig) {
+  if (howsmall >= howbig) return howsmall;
+  return howsmall + random(howbig - howsmall);
+}
+
+void randomSeed(unsigned long seed) {
+  if (seed != 0) randomState = seed;
+}
+
+// ---- Serial ----
+
+size_t HostSerial::printf(const char* fmt, ...) {
+  if (quiet) return 0;
+  va_list args;
+  va_start(args, fmt);
+  int n = vprintf(fmt, args);
+  va_end(args);
+  return n > 0 ? n : 0;
+}
+
+size_t HostSerial::write(const uint8_t* buf, size_t n) {
+  if (out) fwrite(buf, 1, n, out);
+  return n;
+}
+
+// ---- FreeRTOS tasks as threads ----
+
+struct HostTask {
+  std::mutex lock;
+  std::condition_variable wake;
+  uint32_t notifications = 0;
+};
+
+static thread_local HostTask* currentTask = nullptr;
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+  if (!currentTask) currentTask = new HostTask();  // Loop task, created on first use
+  return currentTask;
+}
+
+BaseType_t xTaskCreatePinnedToCore(void (*fn)(void*), const char*, uint32_t, void* arg,
+                                   UBaseType_t, TaskHandle_t* handle, BaseType_t) {
+  HostTask* task = new HostTask();
+  if (handle) *handle = task;
+  std::thread([fn, arg, task]() {
+    currentTask = task;
+    fn(arg);
+  }).detach();
+  return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+  HostTask* task = xTaskGetCurrentTaskHandle();
+  std::unique_lock<std::mutex> guard(task->lock);
+  if (ticks == portMAX_DELAY) {
+    task->wake.wait(guard, [task] { return task->notifications > 0; });
+  } else {
+    task->wake.wait_for(guard, std::chrono::milliseconds(ticks),
+                        [task] { return task->notifications > 0; });
+  }
+  uint32_t value = task->notifications;
+  if (value > 0) task->notifications = clearOnExit ? 0 : value - 1;
+  return value;
+}
+
+void xTaskNotifyGive(TaskHandle_t task) {
+  if (!task) return;
+  {
+    std::lock_guard<std::mutex> guard(task->lock);
+    task->notifications++;
+  }
+  task->wake.notify_one();
+}
+
+void vTaskDelay(TickType_t ticks) {
+  delay(ticks);
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t) {
+  return 1024;  // No stack to measure on the host
+}
+
+// ---- Heap ----
+
+#define HOST_HEAP_SIZE 300000
+
+// Weak so targets without alloc_count.cpp still link
+__attribute__((weak)) HostAllocStats hostAllocStats() {
+  return HostAllocStats{0, 0, 0, 0};
+}
+
+uint32_t HostEsp::getFreeHeap() {
+  return HOST_HEAP_SIZE - hostAllocStats().liveBytes;
+}
+
+uint32_t HostEsp::getMinFreeHeap() {
+  return HOST_HEAP_SIZE - hostAllocStats().peakBytes;
+}
+
+uint32_t HostEsp::getMaxAllocHeap() {
+  return getFreeHeap();
+}
+
+void heap_caps_get_info(multi_heap_info_t* info, uint32_t) {
+  HostAllocStats stats = hostAllocStats();
+  memset(info, 0, sizeof(*info));
+  info->total_free_bytes = HOST_HEAP_SIZE - stats.liveBytes;
+  info->total_allocated_bytes = stats.liveBytes;
+  info->largest_free_block = info->total_free_bytes;
+  info->minimum_free_bytes = HOST_HEAP_SIZE - stats.peakBytes;
+  info->allocated_blocks = stats.liveBlocks;
+}
+
+esp_err_t heap_caps_register_failed_alloc_callback(esp_alloc_failed_hook_t) {
+  return ESP_OK;  // The PC doesn't run out
+}
+
+// ---- SPIFFS ----
+
+static std::string spiffsPath(const char* path) {
+  return std::string(spiffsRoot) + path;
+}
+
+size_t File::write(const uint8_t* buf, size_t size) {
+  if (spiffsWriteDelayUs) delayMicroseconds(spiffsWriteDelayUs);
+  size_t n = fwrite(buf, 1, size, f);
+  spiffsBytesWritten += n;
+  return n;
+}
+
+size_t File::size() {
+  long pos = ftell(f);
+  fseek(f, 0, SEEK_END);
+  long end = ftell(f);
+  fseek(f, pos, SEEK_SET);
+  return end;
+}
+
+int File::available() {
+  return size() - ftell(f);
+}
+
+void File::close() {
+  if (f) fclose(f);
+  f = nullptr;
+}
+
+bool HostSpiffs::begin(bool) {
+  mkdir(spiffsRoot, 0755);
+  return true;
+}
+
+File HostSpiffs::open(const char* path, const char* mode) {
+  std::string full = spiffsPath(path);
+  // Arduino's "r"/"a" modes are binary; add "+" to "a" so size() works
+  if (strcmp(mode, FILE_APPEND) == 0) return File(fopen(full.c_str(), "ab+"));
+  return File(fopen(full.c_str(), strcmp(mode, FILE_WRITE) == 0 ? "wb" : "rb"));
+}
+
+bool HostSpiffs::exists(const char* path) {
+  struct stat st;
+  return stat(spiffsPath(path).c_str(), &st) == 0;
+}
+
+bool HostSpiffs::remove(const char* path) {
+  return ::remove(spiffsPath(path).c_str()) == 0;
+}
+
+bool HostSpiffs::rename(const char* from, const char* to) {
+  return ::rename(spiffsPath(from).c_str(), spiffsPath(to).c_str()) == 0;
+}
+
+// ---- I2S ----
+
+static int i2sSampleRate = 16000;
+
+esp_err_t i2s_driver_install(i2s_port_t, const i2s_config_t* config, int, void*) {
+  i2sSampleRate = config->sample_rate;
+  return ESP_OK;
+}
+
+esp_err_t i2s_set_pin(i2s_port_t, const i2s_pin_config_t*) {
+  return ESP_OK;
+}
+
+esp_err_t i2s_zero_dma_buffer(i2s_port_t) {
+  return ESP_OK;
+}
+
+esp_err_t i2s_write(i2s_port_t, const void* src, size_t size, size_t* written, TickType_t) {
+  if (i2sCapture) fwrite(src, 1, size, i2sCapture);
+  delayMicroseconds((unsigned long)(size / 2) * 1000000 / i2sSampleRate);
+  *written = size;
+  return ESP_OK;
+}
@@ -0,0 +1,167 @@
+// test_audio.cpp - Mixer output, and that effects cost the game loop nothing
+#include "audio.h"
+#include "tetris.h"
+#include "input.h"
+#include "check.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+// ---- Mixer ----
+
+static int blocksUntilSilent() {
+  int16_t block[AUDIO_BLOCK];
+  int blocks = 0;
+  while (mixBlock(block) && blocks < 1000) blocks++;
+  return blocks;
+}
+
+static int peakOf(SoundEffect effect, int copies) {
+  int16_t block[AUDIO_BLOCK];
+  int peak = 0;
+  for (int i = 0; i < copies; i++) playSound(effect);
+  while (mixBlock(block)) {
+    for (int i = 0; i < AUDIO_BLOCK; i++) peak = max(peak, abs(block[i]));
+  }
+  return peak;
+}
+
+static void testMixer() {
+  int16_t block[AUDIO_BLOCK];
+  
+  initAudioMixer();
+  CHECK(!mixBlock(block));
+  
+  // Rotate is a 30 ms tone: 480 samples, two blocks
+  playSound(SFX_ROTATE);
+  CHECK_EQ(blocksUntilSilent(), 2);
+  
+  // Game over is the longest effect (600 ms), and overlapping effects
+  // end when it does
+  playSound(SFX_GAME_OVER);
+  int gameOverBlocks = blocksUntilSilent();
+  CHECK_EQ(gameOverBlocks, (600 * AUDIO_SAMPLE_RATE / 1000 + AUDIO_BLOCK - 1) / AUDIO_BLOCK);
+  playSound(SFX_GAME_OVER);
+  playSound(SFX_ROTATE);
+  playSound(SFX_HOLD);
+  CHECK_EQ(blocksUntilSilent(), gameOverBlocks);
+  
+  // Voices sum exactly: four in phase peak at four times one
+  CHECK_EQ(peakOf(SFX_TETRIS, 1) * AUDIO_VOICES, peakOf(SFX_TETRIS, AUDIO_VOICES));
+}
+
+// ---- Game loop cost ----
+
+#define RUN_MS 4000
+#define ACTION_MS 110  // Just past handleInput()'s 100 ms repeat limit
+
+// Plays a scripted game for RUN_MS and writes the median update() time of
+// frames that pressed a button (rotate or hard drop, both play a sound)
+static void playScripted(bool withAudio, int pipe) {
+  std::vector<unsigned long> actionFrames;
+  unsigned long lastAction = 0;
+  int actions = 0;
+  
+  if (withAudio) initAudio();
+  tetrisGame.init();
+  
+  unsigned long end = millis() + RUN_MS;
+  while (millis() < end) {
+    memset(&buttons, 0, sizeof(buttons));
+    bool action = millis() - lastAction >= ACTION_MS;
+    if (action) {
+      if (actions++ % 3 == 2) buttons.upPressed = true;
+      else buttons.joyBtnPressed = true;
+      lastAction = millis();
+    }
+    
+    unsigned long start = micros();
+    tetrisGame.update();
+    unsigned long elapsed = micros() - start;
+    
+    if (action) actionFrames.push_back(elapsed);
+    if (tetrisGame.isGameOver()) tetrisGame.init();
+    delay(2);
+  }
+  
+  std::sort(actionFrames.begin(), actionFrames.end());
+  unsigned long median = actionFrames[actionFrames.size() / 2];
+  if (write(pipe, &median, sizeof(median)) != sizeof(median)) _exit(1);
+}
+
+static unsigned long medianActionTime(bool withAudio) {
+  int fds[2];
+  unsigned long median = 0;
+  if (pipe(fds) != 0) return 0;
+  
+  fflush(stdout);
+  pid_t pid = fork();
+  if (pid == 0) {
+    Serial.quiet = true;
+    playScripted(withAudio, fds[1]);
+    _exit(0);
+  }
+  waitpid(pid, NULL, 0);
+  if (read(fds[0], &median, sizeof(median)) != sizeof(median)) checkFailures++;
+  close(fds[0]);
+  close(fds[1]);
+  return median;
+}
+
+// What a sound may cost beyond waking a sleeping task. Everything else
+// playSound() does is a bounds check and a ring push.
+#define SOUND_SLACK_US 3
+
+static void idleTask(void* param) {
+  for (;;) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+}
+
+// Median cost of notifying a task that has been asleep as long as the
+// mixer is between button presses. A futex wake here (~10 us) that grows
+// with the idle time, a few us for a FreeRTOS notify on the device.
+static unsigned long wakeCost() {
+  std::vector<unsigned long> calls;
+  TaskHandle_t task = NULL;
+  xTaskCreatePinnedToCore(idleTask, "idle", 1024, NULL, 1, &task, 0);
+  delay(10);
+  for (int i = 0; i < 25; i++) {
+    unsigned long start = micros();
+    xTaskNotifyGive(task);
+    calls.push_back(micros() - start);
+    delay(ACTION_MS);
+  }
+  std::sort(calls.begin(), calls.end());
+  return calls[calls.size() / 2];
+}
+
+// The same scripted game with and without the mixer task running. With
+// audio a button frame may only add the task wake plus a few us.
+static void testUpdateCost() {
+  unsigned long wake = wakeCost();
+  unsigned long silent = medianActionTime(false);
+  unsigned long withAudio = medianActionTime(true);
+  printf("update() on button frames: %lu us silent, %lu us with audio, task wake %lu us\n",
+         silent, withAudio, wake);
+  CHECK(withAudio <= silent + wake + SOUND_SLACK_US);
+  
+  // And the call itself. Back to back the mixer is still busy with the
+  // last effect, so there is no wake, just the ring push.
+  std::vector<unsigned long> calls;
+  initAudio();
+  for (int i = 0; i < 200; i++) {
+    unsigned long start = micros();
+    playSound(SFX_ROTATE);
+    calls.push_back(micros() - start);
+    delay(1);
+  }
+  std::sort(calls.begin(), calls.end());
+  printf("playSound(): %lu us median\n", calls[calls.size() / 2]);
+  CHECK(calls[calls.size() / 2] <= SOUND_SLACK_US);
+}
+
+int main() {
+  testMixer();
+  testUpdateCost();
+  return checkResult("test_audio");
+}
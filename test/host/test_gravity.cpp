@@ -0,0 +1,168 @@
+// test_gravity.cpp - Level speed curve, frame-rate independence and update()
+#include "gravity.h"
+#include "rewind.h"
+#include "input.h"
+#include "check.h"
+
+#include <math.h>
+
+// Intended rows per second for each level (see gravity.cpp)
+static double targetRowsPerSecond(int level) {
+  static const double msPerRow[] = {500, 460, 420, 380, 340, 300, 260, 220, 180, 140, 100,
+                                    80, 60, 40, 25};
+  static const double g[] = {1, 2, 5, 10, 20};
+  if (level <= 15) return 1000.0 / msPerRow[level - 1];
+  return g[level - 16] * 1000000.0 / GRAVITY_TICK_US;
+}
+
+// Ten seconds of play per level at a steady 60 Hz lands within a row
+// (plus 0.5% for the truncated 16.16 step) of the target speed
+static void testLevelProgression() {
+  const int ticks = 600;
+  for (int level = 1; level <= MAX_SPEED_LEVEL; level++) {
+    uint32_t acc = 0;
+    long rows = 0;
+    for (int i = 0; i < ticks; i++) {
+      rows += gravityAdvance(acc, GRAVITY_TICK_US, getLevelSpeed(level).gravity);
+    }
+    double expected = targetRowsPerSecond(level) * ticks * GRAVITY_TICK_US / 1000000.0;
+    if (fabs(rows - expected) > 1.0 + expected * 0.005) {
+      printf("level %d: %ld rows, expected %.1f\n", level, rows, expected);
+      checkFailures++;
+    }
+  }
+}
+
+// Speed only ever goes up and lock delay only ever goes down
+static void testCurveIsMonotonic() {
+  for (int level = 2; level <= MAX_SPEED_LEVEL; level++) {
+    CHECK(getLevelSpeed(level).gravity > getLevelSpeed(level - 1).gravity);
+    CHECK(getLevelSpeed(level).lockDelay <= getLevelSpeed(level - 1).lockDelay);
+  }
+  CHECK(getLevelSpeed(0).gravity == getLevelSpeed(1).gravity);
+  CHECK(getLevelSpeed(99).gravity == getLevelSpeed(MAX_SPEED_LEVEL).gravity);
+  CHECK_EQ(getLevelSpeed(MAX_SPEED_LEVEL).gravity, 20 * GRAVITY_ONE);
+}
+
+// The same wall time split into uneven frames falls the same distance
+static void testFrameJitter() {
+  for (int level = 1; level <= MAX_SPEED_LEVEL; level++) {
+    uint32_t gravity = getLevelSpeed(level).gravity;
+    uint32_t steadyAcc = 0, jitterAcc = 0;
+    long steadyRows = 0, jitterRows = 0;
+    uint32_t elapsed = 0;
+    
+    for (int i = 0; elapsed < 10000000; i++) {
+      uint32_t step = 3000 + (i * 7919) % 40000;  // 3-43 ms frames
+      jitterRows += gravityAdvance(jitterAcc, step, gravity);
+      elapsed += step;
+    }
+    for (uint32_t t = 0; t < elapsed; t += 1000) {
+      steadyRows += gravityAdvance(steadyAcc, 1000, gravity);
+    }
+    if (labs(steadyRows - jitterRows) > 1) {
+      printf("level %d: steady %ld rows, jittered %ld rows\n", level, steadyRows, jitterRows);
+      checkFailures++;
+    }
+  }
+}
+
+// A long stall (menu, flash write) is capped instead of dumping the piece
+static void testStallCap() {
+  uint32_t acc = 0;
+  int rows = gravityAdvance(acc, 5000000, getLevelSpeed(1).gravity);
+  CHECK(rows <= 2);  // 1 s at 500 ms/row
+}
+
+// The rest drive TetrisGame::update() on the stopped host clock
+static TetrisGame game;
+
+// Fresh game with an O piece at spawn on the given level. An O on the
+// empty field rests at y = 16.
+static void startLevel(int level) {
+  RewindState state;
+  game.init();
+  game.saveState(state);
+  state.level = level;
+  state.currentPiece = 0;
+  game.loadState(state);
+}
+
+// One frame at 1G-20G asks for more rows than there is room for at high
+// levels; the piece stops on the stack instead of going through it
+static void testHighGravityClamp() {
+  static const int g[] = {1, 2, 5, 10, 20};
+  
+  for (int level = 16; level <= MAX_SPEED_LEVEL; level++) {
+    startLevel(level);
+    hostClockAdvance(GRAVITY_TICK_US);
+    game.update();
+    CHECK_EQ(game.getPosY(), min(g[level - 16], 16));
+    CHECK_EQ(game.getPiecesPlaced(), 0);
+  }
+  
+  // Same at 20G with an O already sitting in the spawn column
+  startLevel(MAX_SPEED_LEVEL);
+  game.lockAt(FIELD_WIDTH / 2 - 1, 16, 0, 0);
+  RewindState state;
+  game.saveState(state);
+  state.currentPiece = 0;
+  game.loadState(state);
+  hostClockAdvance(GRAVITY_TICK_US);
+  game.update();
+  CHECK_EQ(game.getPosY(), 14);
+}
+
+// A grounded piece locks exactly the current level's lock delay after
+// it lands, not level 1's
+static void testLockDelayFollowsLevel() {
+  CHECK(getLevelSpeed(MAX_SPEED_LEVEL).lockDelay != getLevelSpeed(1).lockDelay);
+  
+  for (int level = 1; level <= MAX_SPEED_LEVEL; level++) {
+    startLevel(level);
+    int ms = 0;
+    while (game.getPosY() < 16 && ms < 20000) {
+      hostClockAdvance(1000);
+      game.update();
+      ms++;
+    }
+    CHECK_EQ(game.getPosY(), 16);
+    
+    int grounded = 0;
+    while (game.getPiecesPlaced() == 0 && grounded < 1000) {
+      hostClockAdvance(1000);
+      game.update();
+      grounded++;
+    }
+    CHECK_EQ(grounded, (int)getLevelSpeed(level).lockDelay);
+  }
+}
+
+// Hard drop lands and locks in the same update, with no time passing
+static void testHardDropLocks() {
+  startLevel(1);
+  hostClockAdvance(200000);  // Past the input repeat guard
+  game.update();
+  CHECK_EQ(game.getPosY(), 0);
+  
+  buttons.upPressed = true;
+  game.update();
+  buttons.upPressed = false;
+  CHECK_EQ(game.getPiecesPlaced(), 1);
+  CHECK_EQ(game.getCell(FIELD_WIDTH / 2 - 1, 17), 1);
+  CHECK_EQ(game.getCell(FIELD_WIDTH / 2, 16), 1);
+}
+
+int main() {
+  testLevelProgression();
+  testCurveIsMonotonic();
+  testFrameJitter();
+  testStallCap();
+  
+  hostClockManual = true;
+  hostClockAdvance(1000000);
+  testHighGravityClamp();
+  testLockDelayFollowsLevel();
+  testHardDropLocks();
+  return checkResult("test_gravity");
+}
@@ -0,0 +1,106 @@
+// test_movegen.cpp - Placement counts and perft values on known positions
+#include <string.h>
+#include "movegen.h"
+#include "check.h"
+
+static TetrisGame game;
+static MoveGenerator gen;
+
+// Cells a placement fills, found by locking it on a copy of the game.
+// Independent of the generator's own cell keys. Returns the count found.
+static int placementCells(const Placement& p, int cells[4]) {
+  TetrisGame copy = game;
+  int found = 0;
+  
+  copy.lockAt(p.x, p.y, p.rot, p.piece);
+  for (int y = 0; y < FIELD_HEIGHT; y++) {
+    for (int x = 0; x < FIELD_WIDTH; x++) {
+      if (copy.getCell(x, y) != game.getCell(x, y) && found < 4) {
+        cells[found++] = y * FIELD_WIDTH + x;  // Row-major, so already sorted
+      }
+    }
+  }
+  return found;
+}
+
+// No two placements may cover the same cells, e.g. O in any rotation or
+// I/S/Z turned 180 degrees
+static void checkDistinctCells(const Placement* moves, int count) {
+  static int cells[MAX_PLACEMENTS][4];
+  
+  for (int i = 0; i < count; i++) {
+    CHECK_EQ(placementCells(moves[i], cells[i]), 4);
+    for (int j = 0; j < i; j++) {
+      CHECK(memcmp(cells[i], cells[j], sizeof(cells[i])) != 0);
+    }
+  }
+}
+
+// One placement per distinct rotation and column on the empty field
+static void testEmptyFieldCounts() {
+  static const int expected[7] = {11, 21, 42, 21, 21, 42, 42};  // O I T S Z J L
+  Placement moves[MAX_PLACEMENTS];
+  
+  game.init();
+  for (int piece = 0; piece < 7; piece++) {
+    gen.load(game);
+    int count = gen.generate(piece, moves, MAX_PLACEMENTS);
+    CHECK_EQ(count, expected[piece]);
+    
+    for (int i = 0; i < count; i++) {
+      CHECK_EQ(moves[i].piece, piece);
+    }
+    checkDistinctCells(moves, count);
+  }
+}
+
+// An I piece roof over columns 0-3 on row 15 leaves a two row pocket
+// underneath. A straight drop lands on the roof; only sliding in along
+// the floor reaches the pocket.
+static void testOverhangTuck() {
+  Placement moves[MAX_PLACEMENTS];
+  
+  game.init();
+  game.lockAt(1, 15, 0, 1);
+  for (int x = 0; x < 4; x++) {
+    CHECK(game.getCell(x, 15) != 0);
+  }
+  
+  gen.load(game);
+  int count = gen.generate(0, moves, MAX_PLACEMENTS);  // O
+  checkDistinctCells(moves, count);
+  
+  bool tucked = false, onRoof = false;
+  for (int i = 0; i < count; i++) {
+    if (moves[i].x == 0 && moves[i].y == 16) tucked = true;
+    if (moves[i].x == 0 && moves[i].y == 13) onRoof = true;
+  }
+  CHECK(tucked);
+  CHECK(onRoof);
+  
+  // Every floor spot from the empty field, plus x = 0..3 on the roof
+  CHECK_EQ(count, 11 + 4);
+}
+
+static void testPerft() {
+  static const uint8_t sequence[] = {0, 1, 2, 3};  // O, I, T, S
+  static const unsigned long expected[] = {11, 231, 9898, 218595};
+  
+  game.init();
+  for (int depth = 1; depth <= 4; depth++) {
+    gen.load(game);
+    CHECK_EQ(gen.perft(sequence, depth), expected[depth - 1]);
+  }
+  
+  // perft() must leave the field as it found it
+  gen.load(game);
+  unsigned long first = gen.perft(sequence, 3);
+  CHECK_EQ(gen.perft(sequence, 3), first);
+}
+
+int main() {
+  testEmptyFieldCounts();
+  testOverhangTuck();
+  testPerft();
+  return checkResult("test_movegen");
+}
@@ -0,0 +1,242 @@
+// test_persist.cpp - Flash log recovery, compaction and write gating
+//
+// Each scenario runs in a forked child so it gets a fresh boot: clean
+// statics and a new flush task, with the log files left on disk in between.
+#include "persist.h"
+#include "check.h"
+#include <SPIFFS.h>
+
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define TEST_ROOT "build/spiffs_persist"
+#define RECORD_SIZE 32
+
+static bool runBoot(void (*scenario)()) {
+  fflush(stdout);
+  pid_t pid = fork();
+  if (pid == 0) {
+    spiffsRoot = TEST_ROOT;
+    scenario();
+    fflush(stdout);
+    _exit(checkFailures ? 1 : 0);
+  }
+  int status = 0;
+  waitpid(pid, &status, 0);
+  if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) checkFailures++;
+  return checkFailures == 0;
+}
+
+static long logSize() {
+  struct stat st;
+  if (stat(TEST_ROOT PERSIST_FILE, &st) != 0) return -1;
+  return st.st_size;
+}
+
+static GameRecord makeGame(int score) {
+  GameRecord game;
+  memset(&game, 0, sizeof(game));
+  game.score = score;
+  game.pieces = score / 10;
+  return game;
+}
+
+// Wait for the flush task to get at least this far, up to 5 s
+static bool waitForBytes(unsigned long bytes) {
+  for (int i = 0; i < 5000 && spiffsBytesWritten < bytes; i++) delay(1);
+  return spiffsBytesWritten >= bytes;
+}
+
+// ---- Round trip ----
+
+static void bootRecordSeven() {
+  initPersist();
+  for (int i = 1; i <= 7; i++) recordGame(makeGame(i * 100));
+  CHECK(waitForBytes(7 * RECORD_SIZE));
+}
+
+static void bootExpectTopFive() {
+  initPersist();
+  for (int rank = 0; rank < HIGH_SCORE_COUNT; rank++) {
+    CHECK_EQ(getHighScore(rank), 700 - rank * 100);
+  }
+}
+
+static void testRoundTrip() {
+  system("rm -rf " TEST_ROOT);
+  runBoot(bootRecordSeven);
+  CHECK_EQ(logSize(), 7 * RECORD_SIZE);
+  runBoot(bootExpectTopFive);
+  CHECK_EQ(logSize(), 7 * RECORD_SIZE);  // Clean log is left alone
+}
+
+// ---- Damage ----
+
+static void bootExpectWithout400() {
+  static const int expected[HIGH_SCORE_COUNT] = {700, 600, 500, 300, 200};
+  initPersist();
+  for (int rank = 0; rank < HIGH_SCORE_COUNT; rank++) {
+    CHECK_EQ(getHighScore(rank), expected[rank]);
+  }
+}
+
+// A bad slot in the middle only loses that game, and a short final
+// record is a torn write. Either way the log is compacted to the table.
+static void testDamagedLog() {
+  system("rm -rf " TEST_ROOT);
+  runBoot(bootRecordSeven);
+  
+  FILE* f = fopen(TEST_ROOT PERSIST_FILE, "r+b");
+  fseek(f, 3 * RECORD_SIZE + 10, SEEK_SET);  // Score 400 game
+  fputc(0x5A, f);
+  fseek(f, 0, SEEK_END);
+  fwrite("torn write", 1, 10, f);
+  fclose(f);
+  
+  runBoot(bootExpectWithout400);
+  CHECK_EQ(logSize(), HIGH_SCORE_COUNT * RECORD_SIZE);
+  runBoot(bootExpectWithout400);
+}
+
+// ---- Compaction ----
+
+static void bootRecordMany() {
+  initPersist();
+  for (int i = 0; i < PERSIST_MAX_RECORDS + 100; i++) {
+    unsigned long before = spiffsBytesWritten;
+    recordGame(makeGame((i * 7919) % 10007));
+    CHECK(waitForBytes(before + RECORD_SIZE));
+    CHECK(logSize() <= (PERSIST_MAX_RECORDS + 1) * RECORD_SIZE);
+  }
+  CHECK_EQ(getDroppedRecords(), 0);
+}
+
+static void bootExpectManyTopFive() {
+  int best[HIGH_SCORE_COUNT] = {0};
+  for (int i = 0; i < PERSIST_MAX_RECORDS + 100; i++) {
+    int score = (i * 7919) % 10007;
+    for (int rank = 0; rank < HIGH_SCORE_COUNT; rank++) {
+      if (score > best[rank]) {
+        memmove(&best[rank + 1], &best[rank], (HIGH_SCORE_COUNT - 1 - rank) * sizeof(int));
+        best[rank] = score;
+        break;
+      }
+    }
+  }
+  
+  initPersist();
+  for (int rank = 0; rank < HIGH_SCORE_COUNT; rank++) {
+    CHECK_EQ(getHighScore(rank), best[rank]);
+  }
+}
+
+// The log stays bounded without a reboot, and keeps the high scores
+static void testRuntimeCompaction() {
+  system("rm -rf " TEST_ROOT);
+  runBoot(bootRecordMany);
+  runBoot(bootExpectManyTopFive);
+}
+
+// ---- Slow flash ----
+
+#define SLOW_WRITE_US 20000
+
+static void bootSlowWrites() {
+  spiffsWriteDelayUs = SLOW_WRITE_US;
+  initPersist();
+  setPersistPaused(true);
+  
+  // In play: queueing is instant and nothing touches flash
+  unsigned long worst = 0;
+  for (int i = 1; i <= 8; i++) {
+    unsigned long start = micros();
+    recordGame(makeGame(i));
+    worst = max(worst, micros() - start);
+  }
+  delay(100);
+  CHECK(worst < 1000);
+  CHECK_EQ(spiffsBytesWritten, 0);
+  
+  // Game over: the batch goes out in the background
+  unsigned long start = micros();
+  setPersistPaused(false);
+  CHECK(micros() - start < 1000);
+  CHECK(waitForBytes(RECORD_SIZE));
+  
+  // A new game starting mid-batch stops the writer after the current record
+  setPersistPaused(true);
+  delay(3 * SLOW_WRITE_US / 1000);
+  unsigned long pausedAt = spiffsBytesWritten;
+  delay(5 * SLOW_WRITE_US / 1000);
+  CHECK(pausedAt < 8 * RECORD_SIZE);
+  CHECK_EQ(spiffsBytesWritten, pausedAt);
+  
+  // The rest goes at the next game over
+  setPersistPaused(false);
+  CHECK(waitForBytes(8 * RECORD_SIZE));
+  CHECK_EQ(getDroppedRecords(), 0);
+}
+
+static void testSlowWrites() {
+  system("rm -rf " TEST_ROOT);
+  runBoot(bootSlowWrites);
+  CHECK_EQ(logSize(), 8 * RECORD_SIZE);
+}
+
+static bool tempExists() {
+  struct stat st;
+  return stat(TEST_ROOT PERSIST_TEMP_FILE, &st) == 0;
+}
+
+// A game starting mid-compaction stops it after the current record and
+// leaves the old log whole; the next game over compacts from scratch
+static void bootPausedCompaction() {
+  initPersist();
+  for (int i = 1; i <= PERSIST_MAX_RECORDS; i++) {
+    unsigned long before = spiffsBytesWritten;
+    recordGame(makeGame(i));
+    CHECK(waitForBytes(before + RECORD_SIZE));
+  }
+  CHECK_EQ(logSize(), PERSIST_MAX_RECORDS * RECORD_SIZE);
+  
+  spiffsWriteDelayUs = SLOW_WRITE_US;
+  unsigned long before = spiffsBytesWritten;
+  recordGame(makeGame(1));  // One over the limit
+  CHECK(waitForBytes(before + 2 * RECORD_SIZE));  // Appended, first copy
+  setPersistPaused(true);
+  delay(3 * SLOW_WRITE_US / 1000);
+  unsigned long pausedAt = spiffsBytesWritten;
+  delay(5 * SLOW_WRITE_US / 1000);
+  CHECK(pausedAt < before + (1 + HIGH_SCORE_COUNT) * RECORD_SIZE);
+  CHECK_EQ(spiffsBytesWritten, pausedAt);
+  CHECK(!tempExists());
+  CHECK_EQ(logSize(), (PERSIST_MAX_RECORDS + 1) * RECORD_SIZE);
+  
+  setPersistPaused(false);
+  for (int i = 0; i < 5000 && logSize() != HIGH_SCORE_COUNT * RECORD_SIZE; i++) delay(1);
+  CHECK_EQ(logSize(), HIGH_SCORE_COUNT * RECORD_SIZE);
+  CHECK(!tempExists());
+}
+
+static void bootExpectLastFive() {
+  initPersist();
+  for (int rank = 0; rank < HIGH_SCORE_COUNT; rank++) {
+    CHECK_EQ(getHighScore(rank), PERSIST_MAX_RECORDS - rank);
+  }
+}
+
+static void testPausedCompaction() {
+  system("rm -rf " TEST_ROOT);
+  runBoot(bootPausedCompaction);
+  runBoot(bootExpectLastFive);
+}
+
+int main() {
+  testRoundTrip();
+  testDamagedLog();
+  testRuntimeCompaction();
+  testSlowWrites();
+  testPausedCompaction();
+  return checkResult("test_persist");
+}
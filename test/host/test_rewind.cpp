@@ -0,0 +1,165 @@
+// test_rewind.cpp - Take-backs restore the field and every stat, and the
+// history buffer reconstructs exactly what was pushed
+#include "rewind.h"
+#include "movegen.h"
+#include "check.h"
+
+#define PIECES 40  // Short of a top-out; play never rewinds a finished game
+
+struct Stats {
+  int score, lines, pieces, level;
+  int clears[4];
+  int piece, held, next;
+  uint8_t cells[FIELD_HEIGHT][FIELD_WIDTH];
+};
+
+static Stats snapshot(TetrisGame& game) {
+  Stats s;
+  s.score = game.getScore();
+  s.lines = game.getLinesCleared();
+  s.pieces = game.getPiecesPlaced();
+  s.level = game.getLevel();
+  for (int i = 0; i < 4; i++) s.clears[i] = game.getClearCount(i + 1);
+  s.piece = game.getCurrentPiece();
+  s.held = game.getHeldPiece();
+  s.next = game.getNextPiece();
+  for (int y = 0; y < FIELD_HEIGHT; y++) {
+    for (int x = 0; x < FIELD_WIDTH; x++) {
+      s.cells[y][x] = game.getCell(x, y);
+    }
+  }
+  return s;
+}
+
+static void checkSame(const Stats& a, const Stats& b) {
+  CHECK_EQ(a.score, b.score);
+  CHECK_EQ(a.lines, b.lines);
+  CHECK_EQ(a.pieces, b.pieces);
+  CHECK_EQ(a.level, b.level);
+  for (int i = 0; i < 4; i++) CHECK_EQ(a.clears[i], b.clears[i]);
+  CHECK_EQ(a.piece, b.piece);
+  CHECK_EQ(a.held, b.held);
+  CHECK_EQ(a.next, b.next);
+  CHECK(memcmp(a.cells, b.cells, sizeof(a.cells)) == 0);
+}
+
+// Bot game of PIECES pieces, which clears a few lines on the way.
+// history[n] is the game after n pieces.
+static void playBot(TetrisGame& game, Stats* history) {
+  static MoveGenerator gen;
+  Placement moves[MAX_PLACEMENTS];
+  int played = 0;
+  
+  game.init();
+  history[0] = snapshot(game);
+  while (played < PIECES && !game.isGameOver()) {
+    gen.load(game);
+    int count = gen.generate(game.getCurrentPiece(), moves, MAX_PLACEMENTS);
+    int best = 0;
+    for (int i = 1; i < count; i++) {
+      if (gen.evaluate(moves[i]) < gen.evaluate(moves[best])) best = i;
+    }
+    game.lockAt(moves[best].x, moves[best].y, moves[best].rot);
+    history[++played] = snapshot(game);
+  }
+  CHECK_EQ(played, PIECES);
+  CHECK(history[played].clears[0] + history[played].clears[1] > 0);
+  CHECK(!game.isPracticeGame());
+}
+
+// Take back 1, 2, 3... pieces at a time, as far as the history goes
+static void testTakeBacks(int maxStep) {
+  static TetrisGame game;
+  static Stats history[PIECES + 1];
+  int back = 0;
+  
+  playBot(game, history);
+  for (int step = 1; game.rewindPieces(step); step = step % maxStep + 1) {
+    back += step;
+    checkSame(snapshot(game), history[PIECES - back]);
+  }
+  CHECK(back >= REWIND_KEY_INTERVAL * 2);
+  CHECK(game.isPracticeGame());
+  
+  game.init();
+  CHECK(!game.isPracticeGame());
+}
+
+// ---- RewindBuffer on its own ----
+
+// Made-up state number n. The bottom changedRows rows differ from state
+// n - 1, like a stack changing; the rows above only come from keyframes.
+static void makeState(RewindState& state, int n, int changedRows) {
+  memset(&state, 0, sizeof(state));
+  for (int y = 0; y < FIELD_HEIGHT; y++) {
+    int version = y >= FIELD_HEIGHT - changedRows ? n : 0;
+    for (int i = 0; i < FIELD_ROW_BYTES; i++) {
+      state.rows[y][i] = (version * 31 + y * 7 + i) & 0x77;
+    }
+  }
+  state.currentPiece = n % 7;
+  state.heldPiece = n % 8 - 1;
+  state.nextPiece = (n * 3) % 7;
+  state.canHold = n & 1;
+  state.score = n * 1237;
+  state.linesCleared = n * 3;
+  state.piecesPlaced = n;
+  for (int i = 0; i < 4; i++) state.clearCounts[i] = n * (i + 1);
+  state.level = 1 + n / 10;
+}
+
+static bool sameState(const RewindState& a, const RewindState& b) {
+  return memcmp(a.rows, b.rows, sizeof(a.rows)) == 0 &&
+         a.currentPiece == b.currentPiece && a.heldPiece == b.heldPiece &&
+         a.nextPiece == b.nextPiece && a.canHold == b.canHold &&
+         a.score == b.score && a.linesCleared == b.linesCleared &&
+         a.piecesPlaced == b.piecesPlaced &&
+         memcmp(a.clearCounts, b.clearCounts, sizeof(a.clearCounts)) == 0 &&
+         a.level == b.level;
+}
+
+// Pushes far past the entry cap, then checks every entry still held
+// decodes to exactly what was pushed, the oldest one included. seek()
+// starts from junk so each result has to come from its keyframe.
+static int pushAndSeek(RewindBuffer& buffer, int pushes, int changedRows) {
+  RewindState state, out;
+  
+  buffer.clear();
+  for (int n = 0; n < pushes; n++) {
+    makeState(state, n, changedRows);
+    buffer.push(state);
+  }
+  
+  int held = buffer.count();
+  CHECK(held > 0 && held <= REWIND_MAX_ENTRIES);
+  for (int back = 0; back < held; back++) {
+    memset(&out, 0xA5, sizeof(out));
+    CHECK(buffer.seek(back, out));
+    makeState(state, pushes - 1 - back, changedRows);
+    CHECK(sameState(out, state));
+  }
+  CHECK(!buffer.seek(held, out));
+  return held;
+}
+
+static void testBufferEviction() {
+  static RewindBuffer buffer;
+  
+  // Small deltas: the entry cap is what evicts, a keyframe group at a time
+  int held = pushAndSeek(buffer, 200, 1);
+  CHECK(held > REWIND_MAX_ENTRIES - REWIND_KEY_INTERVAL);
+  
+  // Half the field changes every push, so the byte budget runs out first
+  // and new entries overwrite the evicted ones. The oldest entry left has
+  // to decode from its own keyframe, not from stale bytes before it.
+  held = pushAndSeek(buffer, 200, FIELD_HEIGHT / 2);
+  CHECK(held < REWIND_MAX_ENTRIES);
+  CHECK(held >= REWIND_KEY_INTERVAL);
+}
+
+int main() {
+  testTakeBacks(1);
+  testTakeBacks(5);
+  testBufferEviction();
+  return checkResult("test_rewind");
+}
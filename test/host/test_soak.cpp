@@ -0,0 +1,63 @@
+// test_soak.cpp - Soak games through the real setup()/loop() on the host
+//
+// main.cpp and the rest of the game are built with ENABLE_SOAK=1, so each
+// loop() is one bot game followed by the normal game over path: flash log
+// record, memory report, overlay and restart, with the persist and audio
+// tasks running. alloc_count.cpp counts every allocation in the process.
+//
+//   build/test_soak [games]   (default 500)
+#include "config.h"
+#include "soak.h"
+#include "memmon.h"
+#include "persist.h"
+#include "check.h"
+#include <SPIFFS.h>
+
+#include <unistd.h>
+
+void setup();
+void loop();
+
+// Up to and including the first memory report, which sets up stdout's buffer
+#define WARMUP_GAMES SOAK_REPORT_GAMES
+
+int main(int argc, char** argv) {
+  int games = argc > 1 ? atoi(argv[1]) : 500;
+  MemorySample mem;
+  
+  system("rm -rf build/spiffs_soak");
+  spiffsRoot = "build/spiffs_soak";
+  
+  setup();
+  
+  // Every task the device would have is up and watched
+  memmonSample(mem, 0);
+  CHECK_EQ(mem.taskCount, 3);
+  
+  for (int i = 0; i < WARMUP_GAMES; i++) loop();
+  HostAllocStats warm = hostAllocStats();
+  
+  unsigned long start = millis();
+  for (int i = WARMUP_GAMES; i < games; i++) loop();
+  unsigned long elapsed = millis() - start;
+  delay(100);  // Let the flush task finish the last record
+  
+  HostAllocStats end = hostAllocStats();
+  int measured = games - WARMUP_GAMES;
+  printf("%d games in %lu ms: %.1f allocations/game, live blocks %lu -> %lu, "
+         "live bytes %lu -> %lu, log %lu bytes\n",
+         measured, elapsed, (double)(end.allocs - warm.allocs) / measured,
+         warm.liveBlocks, end.liveBlocks, warm.liveBytes, end.liveBytes,
+         (unsigned long)spiffsBytesWritten);
+  
+  // Nothing accumulates from game to game, and every game reached the log
+  CHECK(end.liveBlocks <= warm.liveBlocks);
+  CHECK(end.liveBytes <= warm.liveBytes);
+  CHECK_EQ(getDroppedRecords(), 0);
+  CHECK(getHighScore(0) > 0);
+  CHECK(spiffsBytesWritten >= (unsigned long)games * 32);
+  
+  int result = checkResult("test_soak");
+  fflush(stdout);
+  _exit(result);  // Tasks never return, so skip exit()
+}
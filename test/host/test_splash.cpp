@@ -0,0 +1,66 @@
+// test_splash.cpp - The baked splash image decodes to the original artwork
+//
+// The reference is drawn from splash_art.h with the fillRect calls the
+// splash used before it was pre-rasterized; the RLE image goes through
+// drawRleImage() into the host LCD's capture buffer. Every pixel must match.
+#include "display.h"
+#include "splash_art.h"
+#include "splash_assets.h"
+#include "check.h"
+
+static uint16_t reference[HOST_LCD_HEIGHT][HOST_LCD_WIDTH];
+static uint16_t screen[HOST_LCD_HEIGHT][HOST_LCD_WIDTH];
+
+static void fillRect(int x, int y, int w, int h, uint16_t color) {
+  for (int row = y; row < y + h; row++) {
+    for (int col = x; col < x + w; col++) {
+      reference[row][col] = color;
+    }
+  }
+}
+
+static void drawSplashPiece(int x, int y, int type, uint16_t color) {
+  for (int i = 0; i < 4; i++) {
+    fillRect(x + SHAPES[type][i][0] * 8, y + SHAPES[type][i][1] * 8, 7, 7, color);
+  }
+}
+
+static void drawSplashLetter(int x, int y, const uint8_t* letter, uint16_t color) {
+  for (int row = 0; row < 7; row++) {
+    for (int col = 0; col < 5; col++) {
+      if (letter[row] & (1 << (4 - col))) {
+        fillRect(x + col * 4, y + row * 4, 3, 3, color);
+      }
+    }
+  }
+}
+
+static void testSplashDecode() {
+  for (const SplashPiece& p : SPLASH_PIECES) drawSplashPiece(p.x, p.y, p.type, p.color);
+  for (const SplashLetter& l : SPLASH_LETTERS) drawSplashLetter(l.x, l.y, l.glyph, l.color);
+  
+  M5.Lcd.capture = &screen[0][0];
+  M5.Lcd.pixelsPushed = 0;
+  drawRleImage(0, 0, SPLASH_WIDTH, SPLASH_HEIGHT, SPLASH_RLE, COLOR_BLACK);
+  M5.Lcd.capture = nullptr;
+  
+  int drawn = 0, wrong = 0;
+  for (int y = 0; y < HOST_LCD_HEIGHT; y++) {
+    for (int x = 0; x < HOST_LCD_WIDTH; x++) {
+      if (reference[y][x] != COLOR_BLACK) drawn++;
+      if (screen[y][x] != reference[y][x]) {
+        if (wrong++ == 0) printf("first mismatch at %d,%d: %04x, expected %04x\n", x, y, screen[y][x], reference[y][x]);
+      }
+    }
+  }
+  CHECK_EQ(wrong, 0);
+  CHECK(drawn > 0);
+  
+  // Blank lines and the margins either side of the art are skipped
+  CHECK(M5.Lcd.pixelsPushed < SPLASH_WIDTH * SPLASH_HEIGHT / 2);
+}
+
+int main() {
+  testSplashDecode();
+  return checkResult("test_splash");
+}
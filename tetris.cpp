@@ -2,9 +2,27 @@
 #include "tetris.h"
 #include "display.h"
 #include "input.h"
+#include "audio.h"
+#include "rewind.h"
 
 TetrisGame tetrisGame;
 
+// Off-screen 4bpp buffers, pushed to the LCD once per frame
+static uint8_t fieldPixels[FIELD_HEIGHT * BLOCK_SIZE * FIELD_WIDTH * BLOCK_SIZE / 2];
+static uint8_t holdPixels[40 * 40 / 2];
+static uint8_t nextPixels[40 * 40 / 2];
+static IndexedCanvas fieldCanvas(fieldPixels, FIELD_WIDTH * BLOCK_SIZE, FIELD_HEIGHT * BLOCK_SIZE);
+static IndexedCanvas holdCanvas(holdPixels, 40, 40);
+static IndexedCanvas nextCanvas(nextPixels, 40, 40);
+
+// Filled block with white outline, in field cell coordinates
+static void drawBlock(int x, int y, uint8_t color) {
+  int px = x * BLOCK_SIZE;
+  int py = y * BLOCK_SIZE;
+  fieldCanvas.fillRect(px, py, BLOCK_SIZE-1, BLOCK_SIZE-1, color);
+  fieldCanvas.drawRect(px, py, BLOCK_SIZE-1, BLOCK_SIZE-1, PAL_WHITE);
+}
+
 void TetrisGame::init() {
   // Initialize field
   for (int y = 0; y < FIELD_HEIGHT; y++) {
@@ -41,13 +59,25 @@ void TetrisGame::init() {
   pieceColors[5] = COLOR_BLUE;
   pieceColors[6] = COLOR_ORANGE;
   
+  // Field values and palette slots share numbering: piece + 1
+  setPaletteColor(PAL_BLACK, COLOR_BLACK);
+  for (int i = 0; i < 7; i++) {
+    setPaletteColor(i + 1, pieceColors[i]);
+  }
+  setPaletteColor(PAL_WHITE, COLOR_WHITE);
+  setPaletteColor(PAL_GHOST, 0x4208); // Gray
+  
   score = 0;
   level = 1;
   linesCleared = 0;
-  dropSpeed = 500;
+  piecesPlaced = 0;
+  memset(clearCounts, 0, sizeof(clearCounts));
+  practiceGame = false;
+  startTime = millis();
   gameOver = false;
   needsRedraw = true;  // Force border redraw on init
-  lastDropTime = 0;
+  lastGravityTime = micros();
+  gravityAccum = 0;
   lockDelayActive = false;
   
   // Modern features
@@ -56,34 +86,40 @@ void TetrisGame::init() {
   canHold = true;
   
   newPiece(false);
+  
+  // Rewind history starts at the first piece
+  RewindState state;
+  saveState(state);
+  rewindBuffer.clear();
+  rewindBuffer.push(state);
 }
 
 void TetrisGame::update() {
   handleInput();
   
-  if (millis() - lastDropTime > dropSpeed) {
-    posY++;
-    if (test(posY, posX, currentPiece, currentRot)) {
-      posY--;
-      // Start lock delay when piece hits bottom
-      if (!lockDelayActive) {
-        lockDelayActive = true;
-        lockDelayStart = millis();
-      }
-      
-      // Check if lock delay has expired (500ms)
-      if (millis() - lockDelayStart >= 500) {
-        placePiece();
-        clearLines();
-        newPiece(true);
-        if (test(posY, posX, currentPiece, currentRot)) {
-          gameOver = true;
-        }
-      }
-    } else {
-      lockDelayActive = false;
+  const LevelSpeed& speed = getLevelSpeed(level);
+  unsigned long now = micros();
+  int rows = gravityAdvance(gravityAccum, now - lastGravityTime, speed.gravity);
+  lastGravityTime = now;
+  
+  // One collision scan covers any number of rows, all the way up to 20G
+  if (rows > 0) {
+    posY += min(rows, calculateDropDistance());
+  }
+  
+  if (test(posY + 1, posX, currentPiece, currentRot)) {
+    // Start lock delay when piece hits bottom
+    if (!lockDelayActive) {
+      lockDelayActive = true;
+      lockDelayStart = millis();
     }
-    lastDropTime = millis();
+    
+    // Check if lock delay has expired
+    if (millis() - lockDelayStart >= speed.lockDelay) {
+      lockPiece();
+    }
+  } else {
+    lockDelayActive = false;
   }
 }
 
@@ -111,15 +147,11 @@ void TetrisGame::draw() {
   }
   
   // Draw field blocks
+  fieldCanvas.clear(PAL_BLACK);
   for (int y = 0; y < FIELD_HEIGHT; y++) {
     for (int x = 0; x < FIELD_WIDTH; x++) {
-      int px = OFFSET_X + x * BLOCK_SIZE;
-      int py = OFFSET_Y + y * BLOCK_SIZE;
       if (field[y][x] > 0) {
-        M5.Lcd.fillRect(px, py, BLOCK_SIZE-1, BLOCK_SIZE-1, pieceColors[field[y][x]-1]);
-        M5.Lcd.drawRect(px, py, BLOCK_SIZE-1, BLOCK_SIZE-1, COLOR_WHITE);
-      } else {
-        M5.Lcd.fillRect(px, py, BLOCK_SIZE-1, BLOCK_SIZE-1, COLOR_BLACK);
+        drawBlock(x, y, field[y][x]);
       }
     }
   }
@@ -132,13 +164,12 @@ void TetrisGame::draw() {
     int x = posX + pieces[currentPiece][currentRot][1][i];
     int y = posY + pieces[currentPiece][currentRot][0][i];
     if (y >= 0 && y < FIELD_HEIGHT && x >= 0 && x < FIELD_WIDTH) {
-      int px = OFFSET_X + x * BLOCK_SIZE;
-      int py = OFFSET_Y + y * BLOCK_SIZE;
-      M5.Lcd.fillRect(px, py, BLOCK_SIZE-1, BLOCK_SIZE-1, pieceColors[currentPiece]);
-      M5.Lcd.drawRect(px, py, BLOCK_SIZE-1, BLOCK_SIZE-1, COLOR_WHITE);
+      drawBlock(x, y, currentPiece + 1);
     }
   }
   
+  fieldCanvas.push(OFFSET_X, OFFSET_Y);
+  
   // Draw UI elements
   drawHoldPiece();
   drawNextPiece();
@@ -186,8 +217,10 @@ void TetrisGame::handleInput() {
       posY++;
       score += 2; // Award more points for hard drop
     }
-    lockDelayActive = false;
-    lastDropTime = 0; // Force immediate lock
+    // Force immediate lock
+    lockDelayActive = true;
+    lockDelayStart = millis() - getLevelSpeed(level).lockDelay;
+    playSound(SFX_HARD_DROP);
     lastMove = millis();
     buttonHeld = true;
   }
@@ -209,10 +242,17 @@ void TetrisGame::handleInput() {
     if (!test(posY, posX, currentPiece, newRot)) {
       currentRot = newRot;
       if (lockDelayActive) lockDelayStart = millis();
+      playSound(SFX_ROTATE);
     }
     lastMove = millis();
     buttonHeld = true;
   }
+  // Practice mode: take back the last piece (Button B)
+  else if (PRACTICE_MODE && buttons.btnBPressed && !buttonHeld) {
+    rewindPieces(1);
+    lastMove = millis();
+    buttonHeld = true;
+  }
   // Hold piece (Button A)
   else if (buttons.btnAPressed && !buttonHeld) {
     holdPiece();
@@ -235,6 +275,87 @@ bool TetrisGame::test(int y, int x, int piece, int rot) {
   return false;
 }
 
+// Lock in place, clear lines and spawn the next piece
+void TetrisGame::lockPiece() {
+  placePiece();
+  clearLines();
+  newPiece(true);
+  if (test(posY, posX, currentPiece, currentRot)) {
+    gameOver = true;
+    playSound(SFX_GAME_OVER);
+    return;
+  }
+  
+  RewindState state;
+  saveState(state);
+  rewindBuffer.push(state);
+}
+
+// Drop the current piece straight into a resting spot (bots, soak tests)
+void TetrisGame::lockAt(int x, int y, int rot, int piece) {
+  if (piece >= 0) currentPiece = piece;
+  posX = x;
+  posY = y;
+  currentRot = rot;
+  lockPiece();
+}
+
+// Snapshot at a piece spawn, field packed one nibble per cell
+void TetrisGame::saveState(RewindState& state) {
+  for (int y = 0; y < FIELD_HEIGHT; y++) {
+    for (int i = 0; i < FIELD_ROW_BYTES; i++) {
+      state.rows[y][i] = field[y][2 * i] | (field[y][2 * i + 1] << 4);
+    }
+  }
+  state.currentPiece = currentPiece;
+  state.heldPiece = heldPiece;
+  state.nextPiece = nextPiece;
+  state.canHold = canHold;
+  state.score = score;
+  state.linesCleared = linesCleared;
+  state.piecesPlaced = piecesPlaced;
+  for (int i = 0; i < 4; i++) {
+    state.clearCounts[i] = clearCounts[i];
+  }
+  state.level = level;
+}
+
+// Resume from a snapshot with the piece back at its spawn point
+void TetrisGame::loadState(const RewindState& state) {
+  for (int y = 0; y < FIELD_HEIGHT; y++) {
+    for (int i = 0; i < FIELD_ROW_BYTES; i++) {
+      field[y][2 * i] = state.rows[y][i] & 0x0F;
+      field[y][2 * i + 1] = state.rows[y][i] >> 4;
+    }
+  }
+  currentPiece = state.currentPiece;
+  heldPiece = state.heldPiece;
+  nextPiece = state.nextPiece;
+  canHold = state.canHold;
+  score = state.score;
+  linesCleared = state.linesCleared;
+  piecesPlaced = state.piecesPlaced;
+  for (int i = 0; i < 4; i++) {
+    clearCounts[i] = state.clearCounts[i];
+  }
+  level = state.level;
+  
+  currentRot = 0;
+  posX = FIELD_WIDTH / 2 - 1;
+  posY = 0;
+  lockDelayActive = false;
+  gravityAccum = 0;
+  gameOver = false;
+}
+
+bool TetrisGame::rewindPieces(int count) {
+  RewindState state;
+  if (!rewindBuffer.rewind(count, state)) return false;
+  loadState(state);
+  practiceGame = true;
+  return true;
+}
+
 void TetrisGame::placePiece() {
   for (int i = 0; i < 4; i++) {
     int x = posX + pieces[currentPiece][currentRot][1][i];
@@ -243,6 +364,7 @@ void TetrisGame::placePiece() {
       field[y][x] = currentPiece + 1;
     }
   }
+  piecesPlaced++;
 }
 
 void TetrisGame::clearLines() {
@@ -275,13 +397,13 @@ void TetrisGame::clearLines() {
   // Update lines cleared and check for level up
   if (linesThisClear > 0) {
     linesCleared += linesThisClear;
+    clearCounts[linesThisClear - 1]++;
+    playSound(linesThisClear == 4 ? SFX_TETRIS : SFX_LINE_CLEAR);
     
     // Level up every 10 lines
     int newLevel = 1 + (linesCleared / 10);
     if (newLevel > level) {
       level = newLevel;
-      // Speed up (reduce dropSpeed by 10% per level)
-      dropSpeed = max(100, 500 - (level - 1) * 40);
     }
   }
 }
@@ -305,6 +427,7 @@ void TetrisGame::newPiece(bool setPiece) {
   posY = 0;
   
   lockDelayActive = false;
+  gravityAccum = 0;
 }
 
 void TetrisGame::holdPiece() {
@@ -320,10 +443,12 @@ void TetrisGame::holdPiece() {
     currentRot = 0;
     posX = FIELD_WIDTH / 2 - 1;
     posY = 0;
+    gravityAccum = 0;  // Same fresh start newPiece() gives
   }
   
   canHold = false;
   lockDelayActive = false;
+  playSound(SFX_HOLD);
 }
 
 int TetrisGame::calculateDropDistance() {
@@ -346,20 +471,20 @@ void TetrisGame::drawGhostPiece() {
       int x = posX + pieces[currentPiece][currentRot][1][i];
       int y = ghostY + pieces[currentPiece][currentRot][0][i];
       if (y >= 0 && y < FIELD_HEIGHT && x >= 0 && x < FIELD_WIDTH) {
-        int px = OFFSET_X + x * BLOCK_SIZE;
-        int py = OFFSET_Y + y * BLOCK_SIZE;
-        M5.Lcd.drawRect(px, py, BLOCK_SIZE-1, BLOCK_SIZE-1, 0x4208); // Gray
+        int px = x * BLOCK_SIZE;
+        int py = y * BLOCK_SIZE;
+        fieldCanvas.drawRect(px, py, BLOCK_SIZE-1, BLOCK_SIZE-1, PAL_GHOST);
       }
     }
   }
 }
 
-void TetrisGame::drawMiniPiece(int pieceType, int x, int y, int scale) {
+void TetrisGame::drawMiniPiece(IndexedCanvas& canvas, int pieceType, int x, int y, int scale) {
   if (pieceType < 0 || pieceType > 6) return;
   for (int i = 0; i < 4; i++) {
     int px = x + (pieces[pieceType][0][1][i] * scale);
     int py = y + (pieces[pieceType][0][0][i] * scale);
-    M5.Lcd.fillRect(px, py, scale-1, scale-1, pieceColors[pieceType]);
+    canvas.fillRect(px, py, scale-1, scale-1, pieceType + 1);
   }
 }
 
@@ -367,17 +492,17 @@ void TetrisGame::drawHoldPiece() {
   static int lastLines = -1;
   
   // Hold piece area - moved to top left corner
-  M5.Lcd.fillRect(10, 30, 40, 40, COLOR_BLACK);
+  holdCanvas.clear(PAL_BLACK);
+  if (heldPiece >= 0) {
+    drawMiniPiece(holdCanvas, heldPiece, 7, 7, 6);
+  }
+  holdCanvas.push(10, 30);
   M5.Lcd.drawRect(9, 29, 42, 42, COLOR_WHITE);
   M5.Lcd.setTextSize(1);
   M5.Lcd.setTextColor(COLOR_WHITE);
   M5.Lcd.setCursor(20, 75);
   M5.Lcd.print("HOLD");
   
-  if (heldPiece >= 0) {
-    drawMiniPiece(heldPiece, 17, 37, 6);
-  }
-  
   // Draw line counter below hold piece (only when changed)
   if (linesCleared != lastLines) {
     M5.Lcd.fillRect(10, 85, 60, 15, COLOR_BLACK);
@@ -392,80 +517,20 @@ void TetrisGame::drawHoldPiece() {
 
 void TetrisGame::drawNextPiece() {
   // Next piece area  
-  M5.Lcd.fillRect(260, 30, 40, 40, COLOR_BLACK);
+  nextCanvas.clear(PAL_BLACK);
+  if (nextPiece >= 0) {
+    drawMiniPiece(nextCanvas, nextPiece, 7, 7, 6);
+  }
+  nextCanvas.push(260, 30);
   M5.Lcd.drawRect(259, 29, 42, 42, COLOR_WHITE);
   M5.Lcd.setTextSize(1);
   M5.Lcd.setTextColor(COLOR_WHITE);
   M5.Lcd.setCursor(265, 75);
   M5.Lcd.print("NEXT");
-  
-  if (nextPiece >= 0) {
-    drawMiniPiece(nextPiece, 267, 37, 6);
-  }
 }
 
-void TetrisGame::drawHoldButton() {
-  // Simple hold button under NEXT box
-  M5.Lcd.fillCircle(290, 85, 10, COLOR_RED);      // Red circle
-  M5.Lcd.drawCircle(290, 85, 10, COLOR_WHITE);    // White outline
-  
-  // "H" text
-  M5.Lcd.setTextSize(1);
-  M5.Lcd.setTextColor(COLOR_WHITE);
-  M5.Lcd.setCursor(287, 81);
-  M5.Lcd.print("H");
+#if ENABLE_BENCHMARKS
+void fieldCanvasBenchmark() {
+  framebufferBenchmark(fieldCanvas);
 }
-
-void TetrisGame::drawControlBoxes() {
-  // Calculate positions - MUCH larger boxes for human fingers
-  int gameplayBottom = OFFSET_Y + FIELD_HEIGHT * BLOCK_SIZE + 4; // Just below thick border
-  int screenBottom = 240;
-  
-  // Force boxes to start much higher to have room for large boxes
-  gameplayBottom = 160; // Give 80 pixels for large control boxes!
-  
-  int availableHeight = screenBottom - gameplayBottom; // 80 pixels total
-  int boxHeight = (availableHeight - 15) / 2; // About 32-33px each box - 3x taller!
-  int boxWidth = 60; // Keep width the same
-  int leftX = 25;   // Left side boxes
-  int rightX = 320 - boxWidth - 25; // Right side boxes
-  
-  // Top row Y position (rotation boxes)
-  int topY = gameplayBottom + 5;
-  // Bottom row Y position (movement boxes) 
-  int bottomY = topY + boxHeight + 15; // 15px gap between boxes
-  
-  // Left side boxes
-  // Top left: Counter-clockwise rotation - MUCH TALLER
-  M5.Lcd.fillRect(leftX, topY, boxWidth, boxHeight, 0x2104); // Dark gray
-  M5.Lcd.drawRect(leftX, topY, boxWidth, boxHeight, COLOR_CYAN);
-  M5.Lcd.setTextSize(1);
-  M5.Lcd.setTextColor(COLOR_WHITE);
-  M5.Lcd.setCursor(leftX + 10, topY + boxHeight/2 - 3);
-  M5.Lcd.print("↺CCW");
-  
-  // Bottom left: Move left - MUCH TALLER
-  M5.Lcd.fillRect(leftX, bottomY, boxWidth, boxHeight, 0x2104); // Dark gray
-  M5.Lcd.drawRect(leftX, bottomY, boxWidth, boxHeight, COLOR_BLUE);
-  M5.Lcd.setTextSize(1);
-  M5.Lcd.setTextColor(COLOR_WHITE);
-  M5.Lcd.setCursor(leftX + 15, bottomY + boxHeight/2 - 3);
-  M5.Lcd.print("←LEFT");
-  
-  // Right side boxes
-  // Top right: Clockwise rotation - MUCH TALLER
-  M5.Lcd.fillRect(rightX, topY, boxWidth, boxHeight, 0x2104); // Dark gray
-  M5.Lcd.drawRect(rightX, topY, boxWidth, boxHeight, COLOR_CYAN);
-  M5.Lcd.setTextSize(1);
-  M5.Lcd.setTextColor(COLOR_WHITE);
-  M5.Lcd.setCursor(rightX + 15, topY + boxHeight/2 - 3);
-  M5.Lcd.print("CW↻");
-  
-  // Bottom right: Move right - MUCH TALLER
-  M5.Lcd.fillRect(rightX, bottomY, boxWidth, boxHeight, 0x2104); // Dark gray
-  M5.Lcd.drawRect(rightX, bottomY, boxWidth, boxHeight, COLOR_BLUE);
-  M5.Lcd.setTextSize(1);
-  M5.Lcd.setTextColor(COLOR_WHITE);
-  M5.Lcd.setCursor(rightX + 5, bottomY + boxHeight/2 - 3);
-  M5.Lcd.print("RIGHT→");
-}
\ No newline at end of file
+#endif
@@ -3,6 +3,8 @@
 #define TETRIS_H
 
 #include "config.h"
+#include "gravity.h"
+#include "framebuffer.h"
 
 // Scaled up for M5Core2's 320x240 screen - wider gameplay
 #define BLOCK_SIZE 12
@@ -11,7 +13,11 @@
 #define OFFSET_X 90           // Adjusted to re-center the wider field
 #define OFFSET_Y 25
 
+struct RewindState;
+
 class TetrisGame {
+  friend class MoveGenerator;
+  
 private:
   uint8_t field[FIELD_HEIGHT][FIELD_WIDTH];
   int currentPiece;
@@ -19,10 +25,10 @@ private:
   int posX, posY;
   int score;
   int level;
-  unsigned long lastDropTime;
+  unsigned long lastGravityTime;  // micros() of the last gravity step
+  uint32_t gravityAccum;          // Fractional rows, 16.16
   unsigned long lockDelayStart;
   bool lockDelayActive;
-  int dropSpeed;
   bool gameOver;
   bool needsRedraw;  // Flag to ensure border redraws after restart
   
@@ -32,19 +38,24 @@ private:
   bool canHold;
   int linesCleared;
   
+  // Session stats
+  int piecesPlaced;
+  int clearCounts[4];       // Clears of 1, 2, 3 and 4 lines
+  unsigned long startTime;
+  bool practiceGame;        // A piece was taken back
+  
   int pieces[7][4][2][4];
   uint16_t pieceColors[7];
   
   bool test(int y, int x, int piece, int rot);
   void placePiece();
+  void lockPiece();
   void clearLines();
   void newPiece(bool setPiece);
   void drawGhostPiece();
   void drawHoldPiece();
   void drawNextPiece();
-  void drawHoldButton();  // Add hold button
-  void drawControlBoxes(); // Add visual control boxes
-  void drawMiniPiece(int pieceType, int x, int y, int scale);
+  void drawMiniPiece(IndexedCanvas& canvas, int pieceType, int x, int y, int scale);
   int calculateDropDistance();
   void holdPiece();
   
@@ -53,11 +64,33 @@ public:
   void update();
   void draw();
   void handleInput();
+  void lockAt(int x, int y, int rot, int piece = -1);  // -1 = current piece
+  void saveState(RewindState& state);
+  void loadState(const RewindState& state);
+  bool rewindPieces(int count);
   bool isGameOver() { return gameOver; }
+  void endGame() { gameOver = true; }  // For bots that stop early
   int getScore() { return score; }
+  int getLevel() { return level; }
+  int getLinesCleared() { return linesCleared; }
+  int getPiecesPlaced() { return piecesPlaced; }
+  int getClearCount(int lines) { return clearCounts[lines - 1]; }
+  unsigned long getPlayTime() { return millis() - startTime; }
+  bool isPracticeGame() { return practiceGame; }
+  uint8_t getCell(int x, int y) { return field[y][x]; }
+  int getCurrentPiece() { return currentPiece; }
+  int getRotation() { return currentRot; }
+  int getPosX() { return posX; }
+  int getPosY() { return posY; }
+  int getHeldPiece() { return heldPiece; }
+  int getNextPiece() { return nextPiece; }
   const char* getName() { return "TETRIS"; }
 };
 
 extern TetrisGame tetrisGame;
 
+#if ENABLE_BENCHMARKS
+void fieldCanvasBenchmark();  // framebufferBenchmark() on the drawn field
+#endif
+
 #endif
\ No newline at end of file
@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+"""Bake splash_art.h into run-length encoded RGB565 in splash_assets.h.
+
+Runs before every PlatformIO build (extra_scripts in platformio.ini) and
+can be run by hand from anywhere. The output is only rewritten when the
+artwork changes, so it doesn't force a rebuild.
+
+Format: pairs of uint16 (run length, RGB565 color) covering the screen
+left to right, top to bottom. Runs may wrap onto the next line.
+"""
+import os
+import re
+
+SCREEN_WIDTH = 320
+SCREEN_HEIGHT = 240
+BACKGROUND = 0x0000
+
+
+def parse_colors(config):
+    return {name: int(value, 16) for name, value in
+            re.findall(r"#define\s+(COLOR_\w+)\s+(0x[0-9A-Fa-f]+)", config)}
+
+
+def color_value(token, colors):
+    token = token.strip()
+    return colors[token] if token in colors else int(token, 0)
+
+
+def table_body(source, name):
+    match = re.search(name + r"\s*(?:\[[^\]]*\])+\s*=\s*\{(.*?)\};", source, re.S)
+    if not match:
+        raise SystemExit("gen_splash_assets: %s not found in splash_art.h" % name)
+    return re.sub(r"//[^\n]*", "", match.group(1))
+
+
+def parse_art(source, colors):
+    shapes = []
+    for piece in re.findall(r"\{\s*(\{[^{}]*\}(?:\s*,\s*\{[^{}]*\})*)\s*\}", table_body(source, "SHAPES")):
+        shapes.append([tuple(int(v) for v in cell.split(","))
+                       for cell in re.findall(r"\{([^{}]*)\}", piece)])
+
+    letters = {}
+    for name, body in re.findall(r"(LETTER_\w+)\[\d+\]\s*=\s*\{([^}]*)\}", source):
+        letters[name] = [int(v, 0) for v in body.split(",")]
+
+    pieces = []
+    for entry in re.findall(r"\{([^{}]*)\}", table_body(source, "SPLASH_PIECES")):
+        x, y, kind, color = entry.split(",")
+        pieces.append((int(x), int(y), int(kind), color_value(color, colors)))
+
+    glyphs = []
+    for entry in re.findall(r"\{([^{}]*)\}", table_body(source, "SPLASH_LETTERS")):
+        x, y, glyph, color = entry.split(",")
+        glyphs.append((int(x), int(y), letters[glyph.strip()], color_value(color, colors)))
+
+    return shapes, pieces, glyphs
+
+
+def rasterize(shapes, pieces, glyphs):
+    screen = [[BACKGROUND] * SCREEN_WIDTH for _ in range(SCREEN_HEIGHT)]
+
+    def fill_rect(x, y, w, h, color):
+        for yy in range(max(y, 0), min(y + h, SCREEN_HEIGHT)):
+            for xx in range(max(x, 0), min(x + w, SCREEN_WIDTH)):
+                screen[yy][xx] = color
+
+    for x, y, kind, color in pieces:
+        for px, py in shapes[kind]:
+            fill_rect(x + px * 8, y + py * 8, 7, 7, color)
+
+    for x, y, rows, color in glyphs:
+        for row, bits in enumerate(rows):
+            for col in range(5):
+                if bits & (1 << (4 - col)):
+                    fill_rect(x + col * 4, y + row * 4, 3, 3, color)
+
+    return screen
+
+
+def encode(screen):
+    runs = []
+    for pixel in (p for line in screen for p in line):
+        if runs and runs[-1][1] == pixel and runs[-1][0] < 0xFFFF:
+            runs[-1][0] += 1
+        else:
+            runs.append([1, pixel])
+    return runs
+
+
+def render(runs):
+    lines = [
+        "// splash_assets.h - GENERATED by tools/gen_splash_assets.py from splash_art.h",
+        "// Do not edit; change splash_art.h and rebuild.",
+        "#ifndef SPLASH_ASSETS_H",
+        "#define SPLASH_ASSETS_H",
+        "",
+        "#include <stdint.h>",
+        "",
+        "#define SPLASH_WIDTH %d" % SCREEN_WIDTH,
+        "#define SPLASH_HEIGHT %d" % SCREEN_HEIGHT,
+        "#define SPLASH_RUNS %d  // %d bytes vs %d raw" % (
+            len(runs), len(runs) * 4, SCREEN_WIDTH * SCREEN_HEIGHT * 2),
+        "",
+        "// (run length, RGB565) pairs, row-major; kept in flash",
+        "static const uint16_t SPLASH_RLE[SPLASH_RUNS * 2] = {",
+    ]
+    for i in range(0, len(runs), 6):
+        chunk = runs[i:i + 6]
+        lines.append("  " + " ".join("%d, 0x%04X," % (count, color) for count, color in chunk))
+    lines[-1] = lines[-1].rstrip(",")
+    lines += ["};", "", "#endif", ""]
+    return "\n".join(lines)
+
+
+def generate(root):
+    with open(os.path.join(root, "config.h")) as f:
+        colors = parse_colors(f.read())
+    with open(os.path.join(root, "splash_art.h")) as f:
+        art = parse_art(f.read(), colors)
+
+    output = render(encode(rasterize(*art)))
+    path = os.path.join(root, "splash_assets.h")
+    if os.path.exists(path):
+        with open(path) as f:
+            if f.read() == output:
+                return
+    with open(path, "w") as f:
+        f.write(output)
+    print("gen_splash_assets: wrote %s" % path)
+
+
+try:
+    Import("env")  # noqa: F821 - only defined when run by PlatformIO
+    generate(env.subst("$PROJECT_DIR"))  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        generate(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
@@ -0,0 +1,198 @@
+#!/usr/bin/env python3
+"""Decode an M5Core2 Tetris telemetry capture (see telemetry.h).
+
+Capture the serial port to a file with ENABLE_TELEMETRY set, e.g.
+    cat /dev/ttyUSB0 > capture.bin
+then rebuild the game timeline:
+    tools/telemetry_decode.py capture.bin            # one line per tick
+    tools/telemetry_decode.py --field capture.bin    # also draw the field
+    tools/telemetry_decode.py --summary capture.bin  # totals only
+"""
+import argparse
+import struct
+import sys
+
+FIELD_WIDTH = 12
+FIELD_HEIGHT = 18
+
+TYPE_TICK = 1
+TYPE_START = 2
+TYPE_GAME_OVER = 3
+TYPE_MEMORY = 4
+
+ROWS = 0x01
+PIECE = 0x02
+SCORE = 0x04
+LINES = 0x08
+QUEUE = 0x10
+
+PIECE_NAMES = "OITSZJL"
+
+
+def crc8(data):
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def frames(stream):
+    """Yield decoded, CRC-checked frames; None for each corrupt one."""
+    for chunk in stream.split(b"\x00"):
+        if not chunk:
+            continue
+        frame = cobs_decode(chunk)
+        if frame is None or len(frame) < 4 or crc8(frame[:-1]) != frame[-1]:
+            yield None
+        else:
+            yield frame[:-1]
+
+
+class GameState:
+    def __init__(self):
+        self.reset()
+
+    def reset(self):
+        self.field = [[0] * FIELD_WIDTH for _ in range(FIELD_HEIGHT)]
+        self.piece = None
+        self.rot = self.x = self.y = 0
+        self.score = 0
+        self.lines = 0
+        self.level = 1
+        self.held = -1
+        self.next = None
+
+    def apply_tick(self, flags, body):
+        pos = 0
+        changed = []
+        if flags & ROWS:
+            mask = body[pos] | (body[pos + 1] << 8) | (body[pos + 2] << 16)
+            pos += 3
+            for y in range(FIELD_HEIGHT):
+                if not mask & (1 << y):
+                    continue
+                row = []
+                for byte in body[pos:pos + FIELD_WIDTH // 2]:
+                    row += [byte & 0x0F, byte >> 4]
+                pos += FIELD_WIDTH // 2
+                if row != self.field[y]:
+                    changed.append(y)
+                self.field[y] = row
+        if flags & PIECE:
+            packed, x, y = struct.unpack_from("<Bbb", body, pos)
+            pos += 3
+            self.piece, self.rot, self.x, self.y = packed & 0x0F, packed >> 4, x, y
+        if flags & SCORE:
+            (self.score,) = struct.unpack_from("<I", body, pos)
+            pos += 4
+        if flags & LINES:
+            self.lines, self.level = struct.unpack_from("<HB", body, pos)
+            pos += 3
+        if flags & QUEUE:
+            self.held, self.next = struct.unpack_from("<bB", body, pos)
+            pos += 2
+        return changed
+
+    def draw(self):
+        lines = []
+        for y, row in enumerate(self.field):
+            text = "".join(PIECE_NAMES[c - 1] if c else "." for c in row)
+            lines.append("    |" + text + "|")
+        return "\n".join(lines)
+
+
+def name(piece):
+    return PIECE_NAMES[piece] if piece is not None and 0 <= piece < 7 else "-"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("capture", help="raw serial capture file")
+    parser.add_argument("--field", action="store_true", help="print the field when it changes")
+    parser.add_argument("--summary", action="store_true", help="only print totals")
+    args = parser.parse_args()
+
+    with open(args.capture, "rb") as f:
+        stream = f.read()
+
+    state = GameState()
+    last_tick = None
+    good = bad = lost = games = 0
+    frame_times = []
+    memory = []
+
+    for frame in frames(stream):
+        if frame is None:
+            bad += 1
+            continue
+        good += 1
+        kind, tick = struct.unpack_from("<BH", frame, 0)
+        if last_tick is not None and tick != (last_tick + 1) & 0xFFFF:
+            lost += (tick - last_tick - 1) & 0xFFFF
+        last_tick = tick
+
+        if kind == TYPE_START:
+            games += 1
+            state.reset()
+            if not args.summary:
+                print("%5d  --- game %d start ---" % (tick, games))
+        elif kind == TYPE_GAME_OVER:
+            score, lines, level = struct.unpack_from("<IHB", frame, 3)
+            if not args.summary:
+                print("%5d  --- game over: score %d, lines %d, level %d ---" % (tick, score, lines, level))
+        elif kind == TYPE_MEMORY:
+            game, uptime, heap, min_heap, largest, frag, blocks, failed, drift = struct.unpack_from(
+                "<IIIIIBIIi", frame, 3)
+            pos = 36
+            stacks = []
+            while pos + 3 <= len(frame):
+                free, length = struct.unpack_from("<HB", frame, pos)
+                stacks.append("%s=%d" % (frame[pos + 3:pos + 3 + length].decode(errors="replace"), free))
+                pos += 3 + length
+            memory.append((game, heap, min_heap))
+            if not args.summary:
+                print("%5d  --- memory after game %d (%ds): heap %d, min %d, largest %d, frag %d%%, "
+                      "blocks %d, failed %d, drift %d, stack %s ---" % (
+                          tick, game, uptime, heap, min_heap, largest, frag, blocks, failed, drift,
+                          " ".join(stacks)))
+        elif kind == TYPE_TICK:
+            flags, frame_us = struct.unpack_from("<BH", frame, 3)
+            frame_times.append(frame_us)
+            changed = state.apply_tick(flags, frame[6:])
+            if not args.summary:
+                print("%5d  %5dus  %s r%d @%d,%d  score %d  lines %d  L%d  hold %s  next %s%s" % (
+                    tick, frame_us, name(state.piece), state.rot, state.x, state.y,
+                    state.score, state.lines, state.level, name(state.held), name(state.next),
+                    "  rows %s" % changed if changed else ""))
+                if args.field and changed:
+                    print(state.draw())
+        else:
+            bad += 1
+
+    print("frames: %d ok, %d corrupt, %d lost; games started: %d" % (good, bad, lost, games))
+    if frame_times:
+        print("frame time: avg %.0fus, max %dus" % (sum(frame_times) / len(frame_times), max(frame_times)))
+    if memory:
+        print("heap: first %d, last %d, lowest ever %d over %d games" % (
+            memory[0][1], memory[-1][1], min(m[2] for m in memory), memory[-1][0]))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,51 @@
+// touch_regions.h - Screen regions for touch input
+#ifndef TOUCH_REGIONS_H
+#define TOUCH_REGIONS_H
+
+#include "tetris.h"
+
+// The touch panel reaches below the LCD to cover the A/B/C buttons
+#define TOUCH_HEIGHT 280
+
+// Game field plus 5px of slack on every side
+#define FIELD_TOUCH_LEFT (OFFSET_X - 5)
+#define FIELD_TOUCH_RIGHT (OFFSET_X + FIELD_WIDTH * BLOCK_SIZE + 5)
+#define FIELD_TOUCH_TOP (OFFSET_Y - 5)
+#define FIELD_TOUCH_BOTTOM (OFFSET_Y + FIELD_HEIGHT * BLOCK_SIZE + 5)
+
+enum TouchAction : uint8_t {
+  TOUCH_NONE,
+  TOUCH_FIELD,   // Tap = rotate, hold = soft drop
+  TOUCH_LEFT,
+  TOUCH_RIGHT,
+  TOUCH_HOLD
+};
+
+// Inclusive bounds
+struct TouchRegion {
+  int16_t x0, y0, x1, y1;
+  TouchAction action;
+};
+
+// Earlier entries win where regions overlap
+constexpr TouchRegion TOUCH_REGIONS[] = {
+  {280, 75, 300, 95, TOUCH_HOLD},  // Hold button under NEXT
+  {FIELD_TOUCH_LEFT, FIELD_TOUCH_TOP, FIELD_TOUCH_RIGHT, FIELD_TOUCH_BOTTOM, TOUCH_FIELD},
+  {0, 0, FIELD_TOUCH_LEFT - 1, TOUCH_HEIGHT - 1, TOUCH_LEFT},
+  {FIELD_TOUCH_RIGHT + 1, 0, SCREEN_WIDTH - 1, TOUCH_HEIGHT - 1, TOUCH_RIGHT}
+};
+
+#define TOUCH_REGION_COUNT ((int)(sizeof(TOUCH_REGIONS) / sizeof(TOUCH_REGIONS[0])))
+#define REGION_NONE 0xFE
+#define REGION_MIXED 0xFF   // Grid cell straddles a region edge
+
+// Slow path: index of the first region containing the point
+constexpr uint8_t touchRegionAt(int x, int y) {
+  for (int i = 0; i < TOUCH_REGION_COUNT; i++) {
+    const TouchRegion& r = TOUCH_REGIONS[i];
+    if (x >= r.x0 && x <= r.x1 && y >= r.y0 && y <= r.y1) return i;
+  }
+  return REGION_NONE;
+}
+
+#endif